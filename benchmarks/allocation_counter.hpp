@@ -0,0 +1,33 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_ALLOCATION_COUNTER_HPP
+#define ZLEQUALIZER_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+namespace zlBenchmark {
+    /**
+     * counts the heap allocations (the replaceable operator new, see allocation_counter.cpp)
+     * made on any thread since it is constructed
+     */
+    class AllocationCounter {
+    public:
+        AllocationCounter();
+
+        size_t getCount() const;
+
+        size_t getBytes() const;
+
+    private:
+        size_t startCount, startBytes;
+    };
+}
+
+#endif //ZLEQUALIZER_ALLOCATION_COUNTER_HPP
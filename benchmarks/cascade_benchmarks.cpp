@@ -0,0 +1,282 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <random>
+
+#include "dsp/dynamic_filter/dynamic_filter.hpp"
+
+namespace {
+    constexpr size_t bandNum = 3;
+
+    template<typename FloatType>
+    void setStaticBands(std::array<zlDynamicFilter::IIRFilter<FloatType>, bandNum> &filters,
+                        const juce::dsp::ProcessSpec &spec) {
+        constexpr std::array<zlIIR::FilterType, bandNum> types{
+            zlIIR::FilterType::lowShelf, zlIIR::FilterType::peak, zlIIR::FilterType::highShelf
+        };
+        constexpr std::array<float, bandNum> freqs{120.f, 1000.f, 6000.f};
+        constexpr std::array<float, bandNum> gains{4.f, -6.f, 3.f};
+        for (size_t i = 0; i < bandNum; ++i) {
+            auto &f = filters[i];
+            f.prepare(spec);
+            f.setActive(true);
+            f.setBypass(false);
+            f.setDynamicON(false);
+            for (auto *filter: {&f.getBaseFilter(), &f.getMainFilter()}) {
+                filter->setFilterType(types[i]);
+                filter->setFreq(freqs[i]);
+                filter->setGain(gains[i]);
+                filter->setQ(0.707f);
+            }
+        }
+    }
+
+    template<typename FloatType>
+    void fillNoise(juce::AudioBuffer<FloatType> &buffer, std::mt19937 &gen) {
+        std::uniform_real_distribution<FloatType> dist(FloatType(-0.5), FloatType(0.5));
+        for (int c = 0; c < buffer.getNumChannels(); ++c) {
+            for (int i = 0; i < buffer.getNumSamples(); ++i) {
+                buffer.getWritePointer(c)[i] = dist(gen);
+            }
+        }
+    }
+}
+
+TEST_CASE("ParallelCascade switch", "[cascade]") {
+    constexpr int numSamples = 64;
+    const juce::dsp::ProcessSpec spec{48000, numSamples, 2};
+    REQUIRE(zlDynamicFilter::ParallelCascade<double>::isAvailable(2));
+    std::array<zlDynamicFilter::IIRFilter<double>, bandNum> filters, references;
+    setStaticBands(filters, spec);
+    setStaticBands(references, spec);
+    zlDynamicFilter::ParallelCascade<double> parallel;
+    zlDynamicFilter::StaticCascade<double> cascade;
+    parallel.prepare(spec);
+    juce::AudioBuffer<double> buffer(2, numSamples), reference(2, numSamples);
+    std::mt19937 gen(42);
+
+    // the switch to the parallel form must follow the cascade without a jump, as if nothing had changed
+    using Cascade = zlDynamicFilter::ParallelCascade<double>;
+    const auto fadeBlocks = static_cast<int>(spec.sampleRate * (Cascade::maxWarmSeconds + Cascade::rampSeconds)) /
+                            numSamples + 1;
+    double error = 0;
+    int switchBlocks = 0;
+    for (int k = 0; k < 200 + 2 * fadeBlocks; ++k) {
+        if (k == 200) {
+            REQUIRE(parallel.design());
+        }
+        if (k >= 200 && !parallel.getIsParallel()) {
+            switchBlocks += 1;
+        }
+        fillNoise(buffer, gen);
+        reference.makeCopyOf(buffer);
+        parallel.clear();
+        cascade.clear();
+        for (size_t i = 0; i < bandNum; ++i) {
+            parallel.add(filters[i], false);
+            cascade.add(references[i], false);
+        }
+        parallel.process(buffer);
+        cascade.process(reference);
+        for (int c = 0; c < 2; ++c) {
+            for (int i = 0; i < numSamples; ++i) {
+                error = std::max(error, std::abs(buffer.getReadPointer(c)[i] - reference.getReadPointer(c)[i]));
+            }
+        }
+    }
+    CHECK(parallel.getIsParallel());
+    CHECK(error < 1e-6);
+    // the warm-up follows the slowest pole (a 120 Hz shelf) instead of the longest warm-up
+    CHECK(switchBlocks * numSamples < static_cast<int>(spec.sampleRate * Cascade::maxWarmSeconds));
+}
+
+TEST_CASE("ParallelCascade parameter change", "[cascade]") {
+    constexpr int numSamples = 64;
+    const juce::dsp::ProcessSpec spec{48000, numSamples, 2};
+    std::array<zlDynamicFilter::IIRFilter<double>, bandNum> filters, references;
+    setStaticBands(filters, spec);
+    setStaticBands(references, spec);
+    zlDynamicFilter::ParallelCascade<double> parallel;
+    zlDynamicFilter::StaticCascade<double> cascade;
+    parallel.prepare(spec);
+    juce::AudioBuffer<double> buffer(2, numSamples), reference(2, numSamples);
+    std::mt19937 gen(42);
+    using Cascade = zlDynamicFilter::ParallelCascade<double>;
+    const auto warmBlocks = static_cast<int>(spec.sampleRate * Cascade::maxWarmSeconds) / numSamples + 1;
+    const auto processBlock = [&]() {
+        fillNoise(buffer, gen);
+        reference.makeCopyOf(buffer);
+        parallel.clear();
+        cascade.clear();
+        for (size_t i = 0; i < bandNum; ++i) {
+            parallel.add(filters[i], false);
+            cascade.add(references[i], false);
+        }
+        parallel.process(buffer);
+        cascade.process(reference);
+        double error = 0;
+        for (int c = 0; c < 2; ++c) {
+            for (int i = 0; i < numSamples; ++i) {
+                error = std::max(error, std::abs(buffer.getReadPointer(c)[i] - reference.getReadPointer(c)[i]));
+            }
+        }
+        return error;
+    };
+    processBlock();
+    REQUIRE(parallel.design());
+    for (int k = 0; k < 2 * warmBlocks; ++k) {
+        processBlock();
+    }
+    REQUIRE(parallel.getIsParallel());
+
+    // the block with the change requests the decomposition at once (and wakes the designer up)
+    // the decomposition is applied in the next block without a switch between the forms,
+    // then the parallel form follows the cascade as soon as the transient of the late block has decayed
+    for (auto *f: {&filters[1], &references[1]}) {
+        f->getMainFilter().setGain(6.f);
+    }
+    processBlock();
+    CHECK(parallel.design());
+    double error = 0;
+    for (int k = 0; k < 2 * warmBlocks; ++k) {
+        const auto blockError = processBlock();
+        CHECK(parallel.getIsParallel());
+        if (k > warmBlocks) {
+            error = std::max(error, blockError);
+        }
+    }
+    CHECK(error < 1e-6);
+}
+
+TEST_CASE("StaticCascade idle bands", "[cascade]") {
+    constexpr int numSamples = 64;
+    const juce::dsp::ProcessSpec spec{48000, numSamples, 2};
+    // a resonant band rings into a narrow band-pass, whose states stay far below its input
+    std::array<zlDynamicFilter::IIRFilter<double>, 2> filters;
+    std::array<zlIIR::Filter<double>, 2> references;
+    constexpr std::array<zlIIR::FilterType, 2> types{zlIIR::FilterType::peak, zlIIR::FilterType::bandPass};
+    constexpr std::array<float, 2> freqs{40.f, 10000.f};
+    constexpr std::array<float, 2> qs{8.f, 10.f};
+    for (size_t i = 0; i < 2; ++i) {
+        auto &f = filters[i];
+        f.prepare(spec);
+        f.setActive(true);
+        f.setBypass(false);
+        f.setDynamicON(false);
+        for (auto *filter: {&f.getBaseFilter(), &f.getMainFilter(), &references[i]}) {
+            if (filter == &references[i]) { filter->prepare(spec); }
+            filter->setFilterType(types[i]);
+            filter->setFreq(freqs[i]);
+            filter->setGain(12.f);
+            filter->setQ(qs[i]);
+        }
+    }
+    zlDynamicFilter::StaticCascade<double> cascade;
+    juce::AudioBuffer<double> buffer(2, numSamples), reference(2, numSamples);
+    std::mt19937 gen(42);
+
+    // a burst of noise, then silence until both bands sleep
+    double error = 0;
+    for (int k = 0; k < 4000; ++k) {
+        if (k < 20) {
+            fillNoise(buffer, gen);
+        } else {
+            buffer.clear();
+        }
+        reference.makeCopyOf(buffer);
+        cascade.clear();
+        for (auto &f: filters) {
+            cascade.add(f, false);
+        }
+        cascade.process(buffer);
+        for (auto &r: references) {
+            r.process(reference, false);
+        }
+        for (int c = 0; c < 2; ++c) {
+            for (int i = 0; i < numSamples; ++i) {
+                error = std::max(error, std::abs(buffer.getReadPointer(c)[i] - reference.getReadPointer(c)[i]));
+            }
+        }
+    }
+    CHECK(error < 2e-7);
+    CHECK(filters[0].getMainFilter().getIsIdle());
+    CHECK(filters[1].getMainFilter().getIsIdle());
+
+    // the non-silent path, where neither the states nor the input are silent
+    juce::AudioBuffer<double> noise(2, numSamples);
+    fillNoise(noise, gen);
+    BENCHMARK("2 bands, non-silent input") {
+        buffer.makeCopyOf(noise);
+        cascade.process(buffer);
+        return buffer.getReadPointer(0)[0];
+    };
+}
+
+namespace {
+    template<typename FloatType, size_t NumChannels, size_t NumSections>
+    void benchmarkKernels(const std::string &name) {
+        constexpr size_t numSamples = 512;
+        const juce::dsp::ProcessSpec spec{48000, static_cast<juce::uint32>(numSamples), NumChannels};
+        std::array<zlIIR::IIRBase<FloatType>, NumSections> sections;
+        for (auto &s: sections) {
+            s.prepare(spec);
+            s.updateFromBiquad(zlIIR::coeff33{zlIIR::coeff3{1.0, -1.9, 0.91}, zlIIR::coeff3{0.98, -1.9, 0.93}});
+        }
+        juce::AudioBuffer<FloatType> buffer(static_cast<int>(NumChannels), static_cast<int>(numSamples));
+        std::mt19937 gen(42);
+        fillNoise(buffer, gen);
+        auto block = juce::dsp::AudioBlock<FloatType>(buffer);
+        using Lanes = zlIIR::Lanes<FloatType>;
+        alignas(Lanes::alignment) typename Lanes::Tile tile{};
+        alignas(Lanes::alignment) std::array<FloatType, Lanes::tileSize * NumChannels> frames{};
+
+        if (Lanes::isSupported() && NumChannels <= Lanes::size) {
+            BENCHMARK(name + ", SIMD lane tile") {
+                for (size_t start = 0; start < numSamples; start += Lanes::tileSize) {
+                    Lanes::toTile(block, start, Lanes::tileSize, tile.data());
+                    for (auto &s: sections) {
+                        s.template processTile<false>(tile.data(), Lanes::tileSize);
+                    }
+                    Lanes::fromTile(tile.data(), start, Lanes::tileSize, block);
+                }
+                return buffer.getReadPointer(0)[0];
+            };
+        }
+        BENCHMARK(name + ", scalar frames") {
+            for (size_t start = 0; start < numSamples; start += Lanes::tileSize) {
+                for (size_t c = 0; c < NumChannels; ++c) {
+                    for (size_t i = 0; i < Lanes::tileSize; ++i) {
+                        frames[i * NumChannels + c] = block.getChannelPointer(c)[start + i];
+                    }
+                }
+                for (auto &s: sections) {
+                    s.template processFrames<NumChannels, false>(frames.data(), Lanes::tileSize);
+                }
+                for (size_t c = 0; c < NumChannels; ++c) {
+                    for (size_t i = 0; i < Lanes::tileSize; ++i) {
+                        block.getChannelPointer(c)[start + i] = frames[i * NumChannels + c];
+                    }
+                }
+            }
+            return buffer.getReadPointer(0)[0];
+        };
+    }
+}
+
+TEST_CASE("Filter cascade kernels", "[cascade]") {
+    benchmarkKernels<float, 1, 4>("float, 1 channel, 4 sections");
+    benchmarkKernels<float, 2, 1>("float, 2 channels, 1 section");
+    benchmarkKernels<float, 2, 4>("float, 2 channels, 4 sections");
+    benchmarkKernels<float, 2, 16>("float, 2 channels, 16 sections");
+    benchmarkKernels<double, 2, 4>("double, 2 channels, 4 sections");
+    benchmarkKernels<float, 4, 4>("float, 4 channels, 4 sections");
+}
@@ -0,0 +1,355 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <cmath>
+#include <memory>
+#include <random>
+
+#include "dsp/controller.hpp"
+#include "allocation_counter.hpp"
+
+namespace {
+    /**
+     * a processor without buses or parameters, the controller only reports its latency to it
+     */
+    class DummyProcessor : public juce::AudioProcessor {
+    public:
+        const juce::String getName() const override { return "Dummy"; }
+
+        void prepareToPlay(double, int) override {}
+
+        void releaseResources() override {}
+
+        void processBlock(juce::AudioBuffer<float> &, juce::MidiBuffer &) override {}
+
+        juce::AudioProcessorEditor *createEditor() override { return nullptr; }
+
+        bool hasEditor() const override { return false; }
+
+        bool acceptsMidi() const override { return false; }
+
+        bool producesMidi() const override { return false; }
+
+        double getTailLengthSeconds() const override { return 0; }
+
+        int getNumPrograms() override { return 1; }
+
+        int getCurrentProgram() override { return 0; }
+
+        void setCurrentProgram(int) override {}
+
+        const juce::String getProgramName(int) override { return {}; }
+
+        void changeProgramName(int, const juce::String &) override {}
+
+        void getStateInformation(juce::MemoryBlock &) override {}
+
+        void setStateInformation(const void *, int) override {}
+    };
+
+    constexpr size_t staticNum = 4;
+    constexpr size_t dynamicIdx = staticNum;
+
+    template<typename FloatType>
+    void setBands(zlDSP::Controller<FloatType> &controller) {
+        constexpr std::array<zlIIR::FilterType, staticNum> types{
+            zlIIR::FilterType::lowShelf, zlIIR::FilterType::peak,
+            zlIIR::FilterType::peak, zlIIR::FilterType::highShelf
+        };
+        for (size_t i = 0; i < staticNum; ++i) {
+            auto &f = controller.getFilter(i);
+            f.setActive(true);
+            f.setBypass(false);
+            for (auto *filter: {&f.getBaseFilter(), &f.getMainFilter()}) {
+                filter->setFilterType(types[i]);
+                filter->setFreq(100.f * static_cast<float>(4 * i + 1));
+                filter->setGain(3.f);
+                filter->setQ(0.707f);
+            }
+        }
+        auto &f = controller.getFilter(dynamicIdx);
+        f.setActive(true);
+        f.setBypass(false);
+        for (auto *filter: {&f.getBaseFilter(), &f.getMainFilter(), &f.getTargetFilter()}) {
+            filter->setFilterType(zlIIR::FilterType::peak);
+            filter->setFreq(1000.f);
+            filter->setQ(0.707f);
+        }
+        f.getTargetFilter().setGain(-12.f);
+        f.getCompressor().getComputer().setThreshold(-30.f);
+        controller.setSideFreq(1000.f, dynamicIdx);
+        controller.setSideQ(1.f, dynamicIdx);
+        controller.setDynamicON(true, dynamicIdx);
+    }
+
+    /**
+     * a single static peak band which passes the signal unchanged until it becomes dynamic
+     */
+    void setSingleBand(zlDSP::Controller<float> &controller) {
+        controller.setZeroLatency(true);
+        auto &f = controller.getFilter(0);
+        f.setActive(true);
+        f.setBypass(false);
+        for (auto *filter: {&f.getBaseFilter(), &f.getMainFilter(), &f.getTargetFilter()}) {
+            filter->setFilterType(zlIIR::FilterType::peak);
+            filter->setFreq(1000.f);
+            filter->setGain(0.f);
+            filter->setQ(0.707f);
+        }
+        f.getTargetFilter().setGain(-18.f);
+        f.getCompressor().getComputer().setThreshold(-60.f);
+        controller.setSideFreq(1000.f, 0);
+        controller.setSideQ(0.707f, 0);
+    }
+
+    /**
+     * move the parameters of every band, as FiltersAttach does when the host automates them
+     */
+    template<typename FloatType>
+    void automate(zlDSP::Controller<FloatType> &controller, const int k) {
+        const auto phase = static_cast<float>(k % 100) / 100.f;
+        for (size_t i = 0; i < staticNum; ++i) {
+            auto &f = controller.getFilter(i);
+            const auto freq = 100.f * static_cast<float>(4 * i + 1) * (1.f + phase);
+            for (auto *filter: {&f.getBaseFilter(), &f.getMainFilter()}) {
+                filter->setFreq(freq);
+                filter->setGain(-6.f + 12.f * phase);
+                filter->setQ(0.5f + phase);
+            }
+        }
+        auto &f = controller.getFilter(dynamicIdx);
+        for (auto *filter: {&f.getBaseFilter(), &f.getMainFilter(), &f.getTargetFilter()}) {
+            filter->setFreq(1000.f * (1.f + phase));
+        }
+        f.getBaseFilter().setGain(-3.f * phase);
+        f.getCompressor().getComputer().setThreshold(-40.f + 20.f * phase);
+    }
+
+    template<typename FloatType>
+    void fillNoise(juce::AudioBuffer<FloatType> &buffer, std::mt19937 &gen) {
+        std::uniform_real_distribution<FloatType> dist(FloatType(-0.5), FloatType(0.5));
+        for (int c = 0; c < buffer.getNumChannels(); ++c) {
+            for (int i = 0; i < buffer.getNumSamples(); ++i) {
+                buffer.getWritePointer(c)[i] = dist(gen);
+            }
+        }
+    }
+}
+
+TEST_CASE("Controller::process under parameter automation", "[controller]") {
+    // short host blocks use the sub buffers, long ones the block state-space form
+    for (const auto numSamples: {64, 2048}) {
+        const auto name = std::to_string(numSamples) + " samples";
+        DummyProcessor processor;
+        zlDSP::Controller<float> controller(processor);
+        controller.prepare({48000, static_cast<juce::uint32>(numSamples), 4});
+        setBands(controller);
+
+        juce::AudioBuffer<float> buffer(4, numSamples);
+        std::mt19937 gen(42);
+        // warm up, the first blocks switch the forms and design the coefficients
+        for (int k = 0; k < 4; ++k) {
+            fillNoise(buffer, gen);
+            controller.process(buffer);
+        }
+
+        // neither the parameter changes nor the processing allocate on the audio thread
+        constexpr int callNum = 200;
+        const zlBenchmark::AllocationCounter counter;
+        for (int k = 0; k < callNum; ++k) {
+            automate(controller, k);
+            controller.process(buffer);
+        }
+        const auto count = counter.getCount(), bytes = counter.getBytes();
+        WARN(name << ": " << static_cast<double>(count) / callNum << " allocations ("
+            << static_cast<double>(bytes) / callNum << " bytes) per block");
+        CHECK(count == 0);
+
+        int k = 0;
+        BENCHMARK("automated controller, " + name) {
+            automate(controller, k++);
+            controller.process(buffer);
+            return buffer.getReadPointer(0)[0];
+        };
+    }
+}
+
+TEST_CASE("StaticBands::isSideUsed", "[controller]") {
+    // static bands on L/R and on mid, a dynamic band on side
+    zlDSP::StaticBands bands;
+    bands.isStatic.fill(true);
+    bands.lrs.fill(zlDSP::lrType::stereo);
+    bands.lrs[0] = zlDSP::lrType::left;
+    bands.lrs[1] = zlDSP::lrType::right;
+    bands.lrs[2] = zlDSP::lrType::mid;
+    bands.lrs[3] = zlDSP::lrType::side;
+    bands.isStatic[3] = false;
+    bands.isActive.fill(true);
+
+    // the side splitter is skipped when every band on the routes is static
+    CHECK_FALSE(bands.isSideUsed(zlDSP::lrType::left, zlDSP::lrType::right));
+    CHECK(bands.isSideUsed(zlDSP::lrType::mid, zlDSP::lrType::side));
+    // an inactive dynamic band does not read the side chain either
+    bands.isActive[3] = false;
+    CHECK_FALSE(bands.isSideUsed(zlDSP::lrType::mid, zlDSP::lrType::side));
+    // the bands on the other routes do not count
+    bands.lrs[4] = zlDSP::lrType::stereo;
+    bands.isStatic[4] = false;
+    CHECK_FALSE(bands.isSideUsed(zlDSP::lrType::left, zlDSP::lrType::right));
+}
+
+TEST_CASE("Controller applies a band layout change in the next block", "[controller]") {
+    // no message thread runs between the blocks, as in an offline render
+    constexpr int numSamples = 64;
+    DummyProcessor processor;
+    zlDSP::Controller<float> controller(processor), reference(processor);
+    for (auto *c: {&controller, &reference}) {
+        c->prepare({48000, static_cast<juce::uint32>(numSamples), 4});
+        setSingleBand(*c);
+    }
+    juce::AudioBuffer<float> buffer(4, numSamples), refBuffer(4, numSamples), input(4, numSamples);
+    std::mt19937 gen(42);
+    const auto processBoth = [&]() {
+        fillNoise(input, gen);
+        buffer.makeCopyOf(input);
+        refBuffer.makeCopyOf(input);
+        controller.process(buffer);
+        reference.process(refBuffer);
+    };
+    const auto maxDiff = [](const juce::AudioBuffer<float> &x, const juce::AudioBuffer<float> &y, const int c) {
+        float diff = 0.f;
+        for (int i = 0; i < x.getNumSamples(); ++i) {
+            diff = std::max(diff, std::abs(x.getSample(c, i) - y.getSample(c, i)));
+        }
+        return diff;
+    };
+    for (int k = 0; k < 8; ++k) {
+        processBoth();
+    }
+    REQUIRE(maxDiff(buffer, refBuffer, 0) == 0.f);
+
+    SECTION("a dynamic band reads the side chain from the next block on") {
+        controller.setDynamicON(true, 0);
+        float diff = 0.f;
+        for (int k = 0; k < 8; ++k) {
+            processBoth();
+            diff = std::max(diff, maxDiff(buffer, refBuffer, 0));
+        }
+        CHECK(diff > 1e-3f);
+    }
+
+    SECTION("a band moved to the left channel leaves the right channel from the next block on") {
+        // boost the band, so that it changes the signal
+        for (auto *c: {&controller, &reference}) {
+            auto &f = c->getFilter(0);
+            f.getBaseFilter().setGain(12.f);
+            f.getMainFilter().setGain(12.f);
+        }
+        processBoth();
+        controller.setFilterLRs(zlDSP::lrType::left, 0);
+        for (int k = 0; k < 8; ++k) {
+            processBoth();
+            CHECK(maxDiff(buffer, input, 1) < 1e-6f);
+            CHECK(maxDiff(buffer, input, 0) > 1e-3f);
+        }
+    }
+}
+
+TEST_CASE("Controller resumes from rest after a precision switch", "[controller]") {
+    // the double controller processes, the float controller takes over, then the double controller resumes
+    constexpr int numSamples = 64;
+    DummyProcessor processor;
+    // the controllers are too large to share the stack
+    const auto controllerPtr = std::make_unique<zlDSP::Controller<double> >(processor);
+    const auto freshPtr = std::make_unique<zlDSP::Controller<double> >(processor);
+    const auto floatPtr = std::make_unique<zlDSP::Controller<float> >(processor);
+    auto &controller = *controllerPtr, &fresh = *freshPtr;
+    auto &floatController = *floatPtr;
+    for (auto *c: {&controller, &fresh}) {
+        c->prepare({48000, static_cast<juce::uint32>(numSamples), 4});
+        setBands(*c);
+    }
+    floatController.prepare({48000, static_cast<juce::uint32>(numSamples), 4});
+    setBands(floatController);
+
+    juce::AudioBuffer<double> buffer(4, numSamples), freshBuffer(4, numSamples);
+    juce::AudioBuffer<float> floatBuffer(4, numSamples);
+    std::mt19937 gen(42);
+    for (int k = 0; k < 16; ++k) {
+        fillNoise(buffer, gen);
+        controller.process(buffer);
+    }
+    floatController.setToRest();
+    for (int k = 0; k < 16; ++k) {
+        fillNoise(floatBuffer, gen);
+        floatController.process(floatBuffer);
+    }
+    // the resumed controller must not replay the delay, the sub buffers or the detector states of the first part
+    controller.setToRest();
+    double diff = 0;
+    for (int k = 0; k < 16; ++k) {
+        fillNoise(buffer, gen);
+        freshBuffer.makeCopyOf(buffer);
+        controller.process(buffer);
+        fresh.process(freshBuffer);
+        for (int c = 0; c < 2; ++c) {
+            for (int i = 0; i < numSamples; ++i) {
+                diff = std::max(diff, std::abs(buffer.getSample(c, i) - freshBuffer.getSample(c, i)));
+            }
+        }
+    }
+    CHECK(diff < 1e-9);
+}
+
+TEST_CASE("Controller renders automation offline as in real time", "[controller]") {
+    // the offline render processes long blocks in the block state-space form, the real-time one short blocks
+    // the host moves the parameters of the static bands every offlineSamples samples
+    constexpr int realtimeSamples = 64, offlineSamples = 8192, blockNum = 6;
+    DummyProcessor realtimeProcessor, offlineProcessor;
+    offlineProcessor.setNonRealtime(true);
+    const auto realtimePtr = std::make_unique<zlDSP::Controller<double> >(realtimeProcessor);
+    const auto offlinePtr = std::make_unique<zlDSP::Controller<double> >(offlineProcessor);
+    auto &realtime = *realtimePtr, &offline = *offlinePtr;
+    realtime.prepare({48000, static_cast<juce::uint32>(realtimeSamples), 4});
+    offline.prepare({48000, static_cast<juce::uint32>(offlineSamples), 4});
+    for (auto *c: {&realtime, &offline}) {
+        setBands(*c);
+        c->setDynamicON(false, dynamicIdx);
+    }
+
+    juce::AudioBuffer<double> realtimeBuffer(4, offlineSamples * blockNum);
+    std::mt19937 gen(42);
+    fillNoise(realtimeBuffer, gen);
+    juce::AudioBuffer<double> offlineBuffer;
+    offlineBuffer.makeCopyOf(realtimeBuffer);
+    for (int k = 0; k < blockNum; ++k) {
+        automate(offline, k * 10);
+        juce::AudioBuffer<double> block(offlineBuffer.getArrayOfWritePointers(), 4,
+                                        k * offlineSamples, offlineSamples);
+        offline.process(block);
+        automate(realtime, k * 10);
+        for (int i = 0; i < offlineSamples; i += realtimeSamples) {
+            juce::AudioBuffer<double> subBlock(realtimeBuffer.getArrayOfWritePointers(), 4,
+                                               k * offlineSamples + i, realtimeSamples);
+            realtime.process(subBlock);
+        }
+    }
+    double diff = 0, peak = 0;
+    for (int c = 0; c < 2; ++c) {
+        for (int i = 0; i < realtimeBuffer.getNumSamples(); ++i) {
+            diff = std::max(diff, std::abs(realtimeBuffer.getSample(c, i) - offlineBuffer.getSample(c, i)));
+            peak = std::max(peak, std::abs(realtimeBuffer.getSample(c, i)));
+        }
+    }
+    CHECK(peak > 0.1);
+    CHECK(diff < 1e-9);
+}
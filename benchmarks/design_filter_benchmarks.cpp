@@ -0,0 +1,164 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <chrono>
+#include <vector>
+
+#include "reference_design.hpp"
+
+TEST_CASE("DesignFilter::updateCoeff", "[design]") {
+    for (size_t t = 0; t < zlBenchmark::filterTypes.size(); ++t) {
+        for (const auto n: zlBenchmark::orders) {
+            const auto name = std::string(zlBenchmark::filterTypeNames[t]) + " order " + std::to_string(n);
+            zlIIR::DesignSpec spec{zlBenchmark::filterTypes[t], 1000, 48000, 6, 0.707, n};
+            std::array<zlIIR::coeff33, 16> coeffs{};
+
+            // the accuracy against the analog prototypes, at several frequencies, gains and Qs
+            for (const auto f: {50.0, 1000.0, 5000.0}) {
+                for (const auto g: {-18.0, 6.0}) {
+                    for (const auto q: {0.3, 0.707, 4.0}) {
+                        zlIIR::DesignSpec s{spec.filterType, f, spec.fs, g, q, n};
+                        const auto num = zlIIR::DesignFilter::updateCoeff(s.filterType, s.f, s.fs, s.gDB, s.q, s.n,
+                                                                          coeffs);
+                        INFO(name << " f = " << f << " g = " << g << " q = " << q);
+                        CHECK(zlBenchmark::getDesignError(s, coeffs, num) < 0.1);
+                    }
+                }
+            }
+
+            BENCHMARK(std::string(name)) {
+                return zlIIR::DesignFilter::updateCoeff(spec.filterType, spec.f, spec.fs, spec.gDB, spec.q, spec.n,
+                                                        coeffs);
+            };
+        }
+    }
+}
+
+TEST_CASE("DesignFilter::updateCoeff with FastMath", "[design]") {
+    for (size_t t = 0; t < zlBenchmark::filterTypes.size(); ++t) {
+        for (const auto n: {size_t(2), size_t(8)}) {
+            const auto name = std::string(zlBenchmark::filterTypeNames[t]) + " order " + std::to_string(n) +
+                              " (fast math)";
+            zlIIR::DesignSpec spec{zlBenchmark::filterTypes[t], 1000, 48000, 6, 0.707, n, true};
+            std::array<zlIIR::coeff33, 16> coeffs{}, exactCoeffs{};
+
+            // the accuracy against the exact design
+            for (const auto f: {50.0, 1000.0, 15000.0}) {
+                const auto num = zlIIR::DesignFilter::updateCoeff(spec.filterType, f, spec.fs, spec.gDB, spec.q,
+                                                                  spec.n, coeffs, true);
+                const auto exactNum = zlIIR::DesignFilter::updateCoeff(spec.filterType, f, spec.fs, spec.gDB,
+                                                                       spec.q, spec.n, exactCoeffs);
+                REQUIRE(num == exactNum);
+                double error = 0;
+                for (const auto freq: zlIIR::frequencies) {
+                    const auto w = 2 * std::numbers::pi * freq / spec.fs;
+                    const auto exactDB = zlBenchmark::getDigitalDB(exactCoeffs, exactNum, w);
+                    if (exactDB < zlBenchmark::minimumDB) { continue; }
+                    error = std::max(error, std::abs(zlBenchmark::getDigitalDB(coeffs, num, w) - exactDB));
+                }
+                INFO(name << " f = " << f);
+                CHECK(error < 0.01);
+            }
+
+            BENCHMARK(std::string(name)) {
+                return zlIIR::DesignFilter::updateCoeff(spec.filterType, spec.f, spec.fs, spec.gDB, spec.q, spec.n,
+                                                        coeffs, true);
+            };
+        }
+    }
+}
+
+TEST_CASE("DesignFilter::updateCoeffBatch", "[design]") {
+    // 2nd order peaks across the frequency, gain and Q ranges of a band
+    std::vector<zlIIR::DesignSpec> specs;
+    for (const auto f: {20.0, 80.0, 250.0, 1000.0, 4000.0, 15000.0, 20000.0, 23000.0}) {
+        for (const auto g: {-30.0, -6.0, 3.0, 30.0}) {
+            for (const auto q: {0.025, 0.707, 4.0, 25.0}) {
+                specs.push_back({zlIIR::FilterType::peak, f, 48000, g, q, 2});
+            }
+        }
+    }
+    std::vector<std::array<zlIIR::coeff33, 16> > coeffs(specs.size()), exactCoeffs(specs.size());
+    std::vector<size_t> nums(specs.size()), exactNums(specs.size());
+    const auto designBatch = [&]() {
+        zlIIR::DesignFilter::updateCoeffBatch(specs.data(), specs.size(), coeffs.data(), nums.data());
+        return nums[0];
+    };
+    const auto designOneByOne = [&]() {
+        for (size_t i = 0; i < specs.size(); ++i) {
+            const auto &s = specs[i];
+            exactNums[i] = zlIIR::DesignFilter::updateCoeff(s.filterType, s.f, s.fs, s.gDB, s.q, s.n,
+                                                            exactCoeffs[i]);
+        }
+        return exactNums[0];
+    };
+
+    // the batched peaks are as accurate as the exact design, narrow low peaks are ill-conditioned, so that the last
+    // bits of the kernels still show up as small differences in the response
+    designBatch();
+    designOneByOne();
+    for (size_t i = 0; i < specs.size(); ++i) {
+        const auto &s = specs[i];
+        REQUIRE(nums[i] == exactNums[i]);
+        double error = 0;
+        for (const auto freq: zlIIR::frequencies) {
+            const auto w = 2 * std::numbers::pi * freq / s.fs;
+            error = std::max(error, std::abs(zlBenchmark::getDigitalDB(coeffs[i], nums[i], w) -
+                                             zlBenchmark::getDigitalDB(exactCoeffs[i], exactNums[i], w)));
+        }
+        INFO("f = " << s.f << " g = " << s.gDB << " q = " << s.q);
+        CHECK(error < 1e-4);
+    }
+
+    // the batch is faster than designing the peaks one by one, the fastest of several runs is compared
+    const auto getTime = [](const auto &design) {
+        auto best = std::chrono::steady_clock::duration::max();
+        for (size_t run = 0; run < 16; ++run) {
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t rep = 0; rep < 16; ++rep) { design(); }
+            best = std::min(best, std::chrono::steady_clock::now() - start);
+        }
+        return best;
+    };
+    CHECK(getTime(designBatch) < getTime(designOneByOne));
+
+    BENCHMARK("128 peaks (batch)") { return designBatch(); };
+    BENCHMARK("128 peaks (one by one)") { return designOneByOne(); };
+}
+
+TEST_CASE("CoeffCache::prefetch", "[design]") {
+    // peaks, the batched band, and shelves of two orders, each designed exactly and with FastMath
+    std::vector<zlIIR::DesignSpec> specs;
+    for (const auto useFastMath: {false, true}) {
+        for (const auto filterType: {zlIIR::FilterType::peak, zlIIR::FilterType::lowShelf}) {
+            for (const auto n: {size_t(2), size_t(4)}) {
+                for (const auto f: {20.0, 250.0, 1000.0, 15000.0}) {
+                    specs.push_back({filterType, f, 48000, -9, 2, n, useFastMath});
+                }
+            }
+        }
+    }
+    zlIIR::CoeffCache prefetched, reference;
+    prefetched.prefetch(specs.data(), specs.size());
+    std::array<zlIIR::coeff33, 16> coeffs{}, referenceCoeffs{};
+    for (const auto &s: specs) {
+        // a prefetched key holds the same design as a miss
+        const auto num = prefetched.updateCoeff(s.filterType, s.f, s.fs, s.gDB, s.q, s.n, coeffs, s.useFastMath);
+        const auto referenceNum = reference.updateCoeff(s.filterType, s.f, s.fs, s.gDB, s.q, s.n, referenceCoeffs,
+                                                        s.useFastMath);
+        INFO("type " << static_cast<int>(s.filterType) << " order " << s.n << " f = " << s.f
+            << (s.useFastMath ? " (fast math)" : ""));
+        REQUIRE(num == referenceNum);
+        CHECK(std::equal(coeffs.begin(), coeffs.begin() + static_cast<std::ptrdiff_t>(num),
+                         referenceCoeffs.begin()));
+    }
+}
@@ -0,0 +1,121 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <complex>
+
+#include "dsp/iir_filter/coeff/design_filter.hpp"
+
+namespace {
+    using zlIIR::ExactMath;
+    using zlIIR::FastMath;
+
+    double getMagnitudeDB(const std::array<zlIIR::coeff33, 16> &coeffs, const size_t num, const double w) {
+        const auto z = std::polar(1.0, -w);
+        std::complex<double> h{1.0, 0.0};
+        for (size_t i = 0; i < num; ++i) {
+            const auto &[a, b] = coeffs[i];
+            h *= (b[0] + b[1] * z + b[2] * z * z) / (a[0] + a[1] * z + a[2] * z * z);
+        }
+        return 20 * std::log10(std::max(std::abs(h), 1e-300));
+    }
+}
+
+TEST_CASE("FastMath accuracy", "[fast-math]") {
+    SECTION("exp, relative error") {
+        double error = 0;
+        for (double x = -700; x <= 700; x += 0.0137) {
+            error = std::max(error, std::abs(FastMath::exp(x) / ExactMath::exp(x) - 1));
+        }
+        CHECK(error < 3e-10);
+    }
+
+    SECTION("exp clamps the argument to [-700, 700]") {
+        CHECK(FastMath::exp(1000) == FastMath::exp(700));
+        CHECK(FastMath::exp(-1000) == FastMath::exp(-700));
+        CHECK(std::isfinite(FastMath::exp(1e300)));
+        CHECK(FastMath::exp(-1e300) > 0);
+    }
+
+    SECTION("log, absolute error") {
+        double error = 0;
+        for (double k = -300; k <= 300; k += 0.00371) {
+            const auto x = std::pow(10.0, k);
+            error = std::max(error, std::abs(FastMath::log(x) - ExactMath::log(x)));
+        }
+        // around 1, where the reduced argument is the largest relative to the result
+        for (double x = 0.5; x <= 2; x += 1.3e-6) {
+            error = std::max(error, std::abs(FastMath::log(x) - ExactMath::log(x)));
+        }
+        CHECK(error < 1e-9);
+    }
+
+    SECTION("pow, relative error") {
+        // the ratio of the error to its bound
+        double ratio = 0;
+        for (double x = 1e-3; x < 1e3; x *= 1.013) {
+            for (double y = -10; y < 10; y += 0.07) {
+                const auto e = std::abs(FastMath::pow(x, y) / ExactMath::pow(x, y) - 1);
+                ratio = std::max(ratio, e / (3e-10 + 1e-9 * std::abs(y)));
+            }
+        }
+        CHECK(ratio < 1);
+    }
+
+    SECTION("sin/cos, absolute error on [0, pi]") {
+        double error = 0;
+        for (double x = 0; x <= std::numbers::pi; x += 1e-5) {
+            error = std::max(error, std::abs(FastMath::sin(x) - ExactMath::sin(x)));
+            error = std::max(error, std::abs(FastMath::cos(x) - ExactMath::cos(x)));
+        }
+        CHECK(error < 2e-9);
+    }
+
+    SECTION("sin, relative error at low w0") {
+        // 1 Hz at 384 kHz up to 10 Hz at 8 kHz, where the matched designs are ill-conditioned
+        double error = 0;
+        for (double w = 1.6e-5; w <= 8e-3; w *= 1.01) {
+            error = std::max(error, std::abs(FastMath::sin(w) / ExactMath::sin(w) - 1));
+        }
+        CHECK(error < 1e-12);
+    }
+}
+
+TEST_CASE("DesignFilter::updateCoeff with FastMath at low and high w0", "[fast-math]") {
+    std::array<zlIIR::coeff33, 16> coeffs{}, exactCoeffs{};
+    for (const auto filterType: {zlIIR::FilterType::peak, zlIIR::FilterType::lowShelf,
+                                 zlIIR::FilterType::highShelf, zlIIR::FilterType::tiltShelf}) {
+        for (const auto n: {size_t(2), size_t(8)}) {
+            // 20 Hz at 192 kHz, and 20 kHz at 44.1 kHz
+            for (const auto &[f, fs]: {std::pair{20.0, 192000.0}, std::pair{20000.0, 44100.0}}) {
+                const auto num = zlIIR::DesignFilter::updateCoeff(filterType, f, fs, 6, 0.707, n, coeffs, true);
+                const auto exactNum = zlIIR::DesignFilter::updateCoeff(filterType, f, fs, 6, 0.707, n,
+                                                                       exactCoeffs);
+                REQUIRE(num == exactNum);
+                double error = 0;
+                for (double w = 1e-4; w < std::numbers::pi; w *= 1.05) {
+                    error = std::max(error, std::abs(getMagnitudeDB(coeffs, num, w) -
+                                                     getMagnitudeDB(exactCoeffs, num, w)));
+                }
+                INFO("type " << static_cast<int>(filterType) << " order " << n << " f = " << f << " fs = " << fs);
+                CHECK(error < 1e-4);
+            }
+        }
+    }
+}
+
+TEST_CASE("FastMath speed", "[fast-math]") {
+    double x = 0.123;
+    BENCHMARK("std::exp") { return ExactMath::exp(x); };
+    BENCHMARK("FastMath::exp") { return FastMath::exp(x); };
+    BENCHMARK("std::sin") { return ExactMath::sin(x); };
+    BENCHMARK("FastMath::sin") { return FastMath::sin(x); };
+}
@@ -0,0 +1,113 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "reference_design.hpp"
+
+namespace {
+    /**
+     * the reference of StaticGainCompensation::update, the fitted estimations evaluated in double
+     */
+    double getReferenceCompensation(const zlIIR::FilterType filterType, double f, double g, double q) {
+        const auto integrateFQ = [](const double f1, const double f2) {
+            const auto w1 = 1.0000057078597646 + 1.3450513160225395 * 1e-8 * f1 * f1;
+            const auto w2 = 1.0000057078597646 + 1.3450513160225395 * 1e-8 * f2 * f2;
+            return std::log((w1 + 1) * (1 - w2) / (w2 + 1) / (1 - w1));
+        };
+        const auto getEstimation = [](const double fqEffect, const double bw, const double gain,
+                                      const std::array<double, 3> &x) {
+            const auto e = (x[0] * fqEffect + x[1] * bw) * gain * x[2];
+            return gain > 0 ? -std::max(0.0, e) : -std::min(0.0, e);
+        };
+        const auto portion = std::max(std::abs(g) - 12.0, 0.0) / 18.0;
+        g = std::clamp(g, -12.0, 12.0);
+        switch (filterType) {
+            case zlIIR::FilterType::peak: {
+                q = std::clamp(q, 0.1, 5.0);
+                const auto bw = std::asinh(0.5 / q) / std::log(2);
+                const auto scale = std::pow(2, bw / 2);
+                const auto fqEffect = integrateFQ(std::clamp(f / scale, 10.0, 20000.0),
+                                                  std::clamp(f * scale, 10.0, 20000.0));
+                const auto e = g > 0
+                                   ? getEstimation(fqEffect, bw, g, {0.6797385437634612, 0.6501623179337382,
+                                                                     0.1661043031674446})
+                                   : getEstimation(fqEffect, bw, g, {1.0005839027125558, 0.2615438074138483,
+                                                                     0.0876180361048472});
+                return (1 + portion * 0.75) * e;
+            }
+            case zlIIR::FilterType::lowShelf: {
+                f = std::clamp(f, 15.0, 5000.0);
+                const auto bw = std::log2(f / 10);
+                const auto fqEffect = integrateFQ(10, f);
+                const auto e = g > 0
+                                   ? getEstimation(fqEffect, bw, g, {0.5615303279130026, 1.0955796383939556,
+                                                                     0.0578375534446572})
+                                   : getEstimation(fqEffect, bw, g, {1.7666900390139590, -0.9879875452397923,
+                                                                     0.0466874416227134});
+                return (0.88 + portion * 0.66) * e;
+            }
+            case zlIIR::FilterType::highShelf: {
+                f = std::clamp(f, 200.0, 18000.0);
+                const auto bw = std::log2(20000 / f);
+                const auto fqEffect = integrateFQ(f, 20000);
+                const auto e = g > 0
+                                   ? getEstimation(fqEffect, bw, g, {-1.6271905034386083, 2.6722453328537070,
+                                                                     0.1780141475194901})
+                                   : getEstimation(fqEffect, bw, g, {-0.0999799556355004, 1.0888973867418563,
+                                                                     0.0760070892708112});
+                return (0.5 + portion * 0.375) * e;
+            }
+            case zlIIR::FilterType::lowPass:
+            case zlIIR::FilterType::highPass:
+            case zlIIR::FilterType::notch:
+            case zlIIR::FilterType::bandPass:
+            case zlIIR::FilterType::tiltShelf:
+            case zlIIR::FilterType::bandShelf:
+            default:
+                return 0;
+        }
+    }
+}
+
+TEST_CASE("StaticGainCompensation::update", "[compensation]") {
+    for (size_t t = 0; t < zlBenchmark::filterTypes.size(); ++t) {
+        const auto name = std::string(zlBenchmark::filterTypeNames[t]);
+        zlIIR::Filter<float> filter;
+        zlIIR::StaticGainCompensation<float> compensation(filter);
+        filter.prepare({48000, 512, 2});
+        compensation.prepare({48000, 512, 2});
+        compensation.enable(true);
+        filter.setFilterType(zlBenchmark::filterTypes[t]);
+
+        // the accuracy against the estimations evaluated in double
+        for (const auto f: {20.f, 100.f, 1000.f, 8000.f, 19000.f}) {
+            for (const auto g: {-24.f, -6.f, 3.f, 18.f}) {
+                for (const auto q: {0.05f, 0.707f, 8.f}) {
+                    filter.setFreq(f);
+                    filter.setGain(g);
+                    filter.setQ(q);
+                    compensation.update();
+                    const auto reference = getReferenceCompensation(zlBenchmark::filterTypes[t], f, g, q);
+                    INFO(name << " f = " << f << " g = " << g << " q = " << q);
+                    CHECK(std::abs(static_cast<double>(compensation.getGainDecibels()) - reference) < 0.01);
+                }
+            }
+        }
+
+        filter.setFreq(1000.f);
+        filter.setGain(6.f);
+        filter.setQ(0.707f);
+        BENCHMARK(std::string(name)) {
+            compensation.update();
+            return compensation.getGainDecibels();
+        };
+    }
+}
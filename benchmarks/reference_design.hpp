@@ -0,0 +1,80 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_REFERENCE_DESIGN_HPP
+#define ZLEQUALIZER_REFERENCE_DESIGN_HPP
+
+#include <complex>
+
+#include "dsp/iir_filter/iir_filter.hpp"
+
+namespace zlBenchmark {
+    inline constexpr std::array filterTypes{
+        zlIIR::FilterType::peak, zlIIR::FilterType::lowShelf, zlIIR::FilterType::lowPass,
+        zlIIR::FilterType::highShelf, zlIIR::FilterType::highPass, zlIIR::FilterType::notch,
+        zlIIR::FilterType::bandPass, zlIIR::FilterType::tiltShelf, zlIIR::FilterType::bandShelf
+    };
+
+    inline constexpr std::array filterTypeNames{
+        "peak", "low shelf", "low pass", "high shelf", "high pass", "notch", "band pass", "tilt shelf", "band shelf"
+    };
+
+    inline constexpr std::array<size_t, 7> orders{1, 2, 4, 6, 8, 12, 16};
+
+    /** responses below it are too deep to compare in dB */
+    inline constexpr double minimumDB = -60.0;
+
+    /**
+     * the response (dB) of digital sections, evaluated directly as a product of complex ratios
+     */
+    inline double getDigitalDB(const std::array<zlIIR::coeff33, 16> &coeffs, const size_t num, const double w) {
+        const auto z = std::polar(1.0, -w);
+        std::complex<double> h{1.0, 0.0};
+        for (size_t i = 0; i < num; ++i) {
+            const auto &[a, b] = coeffs[i];
+            h *= (b[0] + b[1] * z + b[2] * z * z) / (a[0] + a[1] * z + a[2] * z * z);
+        }
+        return 20 * std::log10(std::max(std::abs(h), 1e-12));
+    }
+
+    /**
+     * the response (dB) of analog prototype sections (in ascending powers of s)
+     */
+    inline double getAnalogDB(const std::array<zlIIR::coeff33, 16> &coeffs, const size_t num, const double w) {
+        const auto s = std::complex<double>{0.0, w};
+        std::complex<double> h{1.0, 0.0};
+        for (size_t i = 0; i < num; ++i) {
+            const auto &[a, b] = coeffs[i];
+            h *= (b[0] + b[1] * s + b[2] * s * s) / (a[0] + a[1] * s + a[2] * s * s);
+        }
+        return 20 * std::log10(std::max(std::abs(h), 1e-12));
+    }
+
+    /**
+     * the maximum deviation (dB) of the designed sections from the reference design (the analog prototype)
+     * below analogMaxW, where the matched designs are meant to follow their prototypes
+     */
+    inline double getDesignError(const zlIIR::DesignSpec &spec,
+                                 const std::array<zlIIR::coeff33, 16> &coeffs, const size_t num) {
+        std::array<zlIIR::coeff33, 16> analogCoeffs{};
+        const auto analogNum = zlIIR::DesignFilter::updateAnalogCoeff(spec.filterType, spec.f, spec.fs, spec.gDB,
+                                                                      spec.q, spec.n, analogCoeffs);
+        double error = 0;
+        for (double f = 10; 2 * std::numbers::pi * f / spec.fs <= zlIIR::ResponseEngine::analogMaxW; f *= 1.05) {
+            const auto w = 2 * std::numbers::pi * f / spec.fs;
+            const auto digitalDB = getDigitalDB(coeffs, num, w);
+            const auto analogDB = getAnalogDB(analogCoeffs, analogNum, w);
+            if (digitalDB < minimumDB && analogDB < minimumDB) { continue; }
+            error = std::max(error, std::abs(digitalDB - analogDB));
+        }
+        return error;
+    }
+}
+
+#endif //ZLEQUALIZER_REFERENCE_DESIGN_HPP
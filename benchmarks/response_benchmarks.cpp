@@ -0,0 +1,106 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "reference_design.hpp"
+
+namespace {
+    void setFilter(zlIIR::Filter<double> &filter, const zlIIR::FilterType filterType, const double fs) {
+        filter.prepare({fs, 512, 2});
+        filter.setFilterType(filterType);
+        filter.setOrder(4);
+        filter.setFreq(1000);
+        filter.setGain(6);
+        filter.setQ(0.707);
+        filter.updateParasForDBOnly();
+    }
+}
+
+TEST_CASE("Filter::updateDBs", "[response]") {
+    for (size_t t = 0; t < zlBenchmark::filterTypes.size(); ++t) {
+        const auto name = std::string(zlBenchmark::filterTypeNames[t]);
+        zlIIR::Filter<double> filter;
+        setFilter(filter, zlBenchmark::filterTypes[t], 48000);
+        filter.setMagOutdated(true);
+        filter.updateDBs();
+
+        // the accuracy against the direct evaluation of the sections
+        double error = 0;
+        for (size_t k = 0; k < zlIIR::frequencies.size(); ++k) {
+            const auto w = 2 * std::numbers::pi * zlIIR::frequencies[k] / 48000;
+            const auto referenceDB = zlBenchmark::getDigitalDB(filter.getCoeffs(), filter.getFilterNum(), w);
+            // the notch is drawn with a marked dip, see Filter::updateDBs
+            if (referenceDB < zlBenchmark::minimumDB || filter.getDBs()[k] <= -90) { continue; }
+            error = std::max(error, std::abs(filter.getDBs()[k] - referenceDB));
+        }
+        INFO(name);
+        CHECK(error < 1e-6);
+
+        BENCHMARK(std::string(name)) {
+            filter.setMagOutdated(true);
+            filter.updateDBs();
+            return filter.getDBs()[0];
+        };
+    }
+}
+
+TEST_CASE("Filter::updateDBs with analog curves", "[response]") {
+    for (size_t t = 0; t < zlBenchmark::filterTypes.size(); ++t) {
+        if (!zlIIR::ResponseEngine::isAnalogMatched(zlBenchmark::filterTypes[t], 192000)) { continue; }
+        const auto name = std::string(zlBenchmark::filterTypeNames[t]) + " (analog)";
+        zlIIR::Filter<double> filter;
+        filter.setAnalogCurveON(true);
+        setFilter(filter, zlBenchmark::filterTypes[t], 192000);
+        filter.setMagOutdated(true);
+        filter.updateDBs();
+
+        // the accuracy against the direct evaluation of the designed sections
+        double error = 0;
+        for (size_t k = 0; k < zlIIR::frequencies.size(); ++k) {
+            const auto w = 2 * std::numbers::pi * zlIIR::frequencies[k] / 192000;
+            const auto referenceDB = zlBenchmark::getDigitalDB(filter.getCoeffs(), filter.getFilterNum(), w);
+            if (referenceDB < zlBenchmark::minimumDB || filter.getDBs()[k] <= -90) { continue; }
+            error = std::max(error, std::abs(filter.getDBs()[k] - referenceDB));
+        }
+        INFO(name);
+        CHECK(error < 0.15);
+
+        BENCHMARK(std::string(name)) {
+            filter.setMagOutdated(true);
+            filter.updateDBs();
+            return filter.getDBs()[0];
+        };
+    }
+}
+
+TEST_CASE("Filter::getDB", "[response]") {
+    for (size_t t = 0; t < zlBenchmark::filterTypes.size(); ++t) {
+        const auto name = std::string(zlBenchmark::filterTypeNames[t]);
+        zlIIR::Filter<double> filter;
+        setFilter(filter, zlBenchmark::filterTypes[t], 48000);
+        filter.setMagOutdated(true);
+        filter.updateDBs();
+
+        for (const auto f: {20.0, 500.0, 1000.0, 2000.0, 15000.0}) {
+            const auto w = 2 * std::numbers::pi * f / 48000;
+            const auto referenceDB = zlBenchmark::getDigitalDB(filter.getCoeffs(), filter.getFilterNum(), w);
+            if (referenceDB < zlBenchmark::minimumDB) { continue; }
+            INFO(name << " f = " << f);
+            CHECK(std::abs(filter.getDB(f) - referenceDB) < 1e-6);
+        }
+
+        double f = 20;
+        BENCHMARK(std::string(name)) {
+            f = f > 20000 ? 20 : f * 1.01;
+            return filter.getDB(f);
+        };
+    }
+}
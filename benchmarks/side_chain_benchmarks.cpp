@@ -0,0 +1,336 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <deque>
+#include <numeric>
+#include <random>
+
+#include "dsp/dynamic_filter/dynamic_filter.hpp"
+#include "dsp/splitter/splitter.hpp"
+#include "allocation_counter.hpp"
+
+namespace {
+    void fillNoise(juce::AudioBuffer<float> &buffer, std::mt19937 &gen) {
+        std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+        for (int c = 0; c < buffer.getNumChannels(); ++c) {
+            for (int i = 0; i < buffer.getNumSamples(); ++i) {
+                buffer.getWritePointer(c)[i] = dist(gen);
+            }
+        }
+    }
+
+    void setSideFilter(zlIIR::Filter<float> &filter, const juce::dsp::ProcessSpec &spec) {
+        filter.setOrder(2, false);
+        filter.setFilterType(zlIIR::FilterType::bandPass, false);
+        filter.prepare(spec);
+        filter.setFreq(1000.f);
+        filter.setQ(1.f);
+    }
+
+    void setDynamicBand(zlDynamicFilter::IIRFilter<float> &filter, const juce::dsp::ProcessSpec &spec) {
+        filter.prepare(spec);
+        filter.setActive(true);
+        filter.setBypass(false);
+        filter.setDynamicON(true);
+        for (auto *f: {&filter.getBaseFilter(), &filter.getMainFilter(), &filter.getTargetFilter()}) {
+            f->setFilterType(zlIIR::FilterType::peak);
+            f->setFreq(1000.f);
+            f->setQ(0.707f);
+        }
+        filter.getBaseFilter().setGain(0.f);
+        filter.getTargetFilter().setGain(-12.f);
+        filter.getSideFilter().setFreq(1000.f);
+        filter.getSideFilter().setQ(1.f);
+        filter.getCompressor().getComputer().setThreshold(-30.f);
+    }
+}
+
+TEST_CASE("Filter::processTo", "[side-chain]") {
+    const juce::dsp::ProcessSpec spec{48000, 512, 2};
+    zlIIR::Filter<float> filter, reference;
+    setSideFilter(filter, spec);
+    setSideFilter(reference, spec);
+    juce::AudioBuffer<float> input(2, 512), inputCopy(2, 512), inputSaved(2, 512), output(2, 512);
+    std::mt19937 gen(42);
+
+    // the out-of-place pass writes the same samples as the in-place pass on a copy, and leaves the input as it is
+    for (int i = 0; i < 8; ++i) {
+        fillNoise(input, gen);
+        inputCopy.makeCopyOf(input);
+        inputSaved.makeCopyOf(input);
+        reference.process(inputCopy);
+        filter.processTo(juce::dsp::AudioBlock<const float>(input), juce::dsp::AudioBlock<float>(output));
+        bool isSame = true, isInputKept = true;
+        for (int c = 0; c < 2; ++c) {
+            for (int j = 0; j < 512; ++j) {
+                isSame = isSame && output.getReadPointer(c)[j] == inputCopy.getReadPointer(c)[j];
+                isInputKept = isInputKept && input.getReadPointer(c)[j] == inputSaved.getReadPointer(c)[j];
+            }
+        }
+        CHECK(isSame);
+        CHECK(isInputKept);
+    }
+
+    const auto inputBlock = juce::dsp::AudioBlock<const float>(input);
+    auto outputBlock = juce::dsp::AudioBlock<float>(output);
+    BENCHMARK("side filter, 512 samples") {
+        filter.processTo(inputBlock, outputBlock);
+        return output.getReadPointer(0)[0];
+    };
+}
+
+TEST_CASE("IIRFilter::process with a dynamic band", "[side-chain]") {
+    for (const auto numSamples: {64, 512}) {
+        const auto name = "dynamic band, " + std::to_string(numSamples) + " samples";
+        const juce::dsp::ProcessSpec spec{48000, static_cast<juce::uint32>(numSamples), 2};
+        zlDynamicFilter::IIRFilter<float> filter;
+        setDynamicBand(filter, spec);
+
+        juce::AudioBuffer<float> mBuffer(2, numSamples), sBuffer(2, numSamples);
+        std::mt19937 gen(42);
+        fillNoise(sBuffer, gen);
+        // warm up, the first blocks design the coefficients
+        for (int i = 0; i < 4; ++i) {
+            fillNoise(mBuffer, gen);
+            filter.process(mBuffer, sBuffer);
+        }
+
+        // the side-chain path neither allocates nor copies the side-chain into a buffer
+        constexpr int callNum = 100;
+        const zlBenchmark::AllocationCounter counter;
+        for (int i = 0; i < callNum; ++i) {
+            filter.process(mBuffer, sBuffer);
+        }
+        const auto count = counter.getCount(), bytes = counter.getBytes();
+        WARN(name << ": " << static_cast<double>(count) / callNum << " allocations ("
+            << static_cast<double>(bytes) / callNum << " bytes) per call");
+        CHECK(count == 0);
+
+        BENCHMARK(std::string(name)) {
+            filter.process(mBuffer, sBuffer);
+            return mBuffer.getReadPointer(0)[0];
+        };
+    }
+}
+
+TEST_CASE("IIRFilter::process with a shared side chain", "[side-chain]") {
+    constexpr int numSamples = 64;
+    constexpr size_t bandNum = 4;
+    const juce::dsp::ProcessSpec spec{48000, numSamples, 2};
+    std::array<zlDynamicFilter::IIRFilter<float>, bandNum> bands, references;
+    for (size_t i = 0; i < bandNum; ++i) {
+        setDynamicBand(bands[i], spec);
+        setDynamicBand(references[i], spec);
+        // the bands differ in their main filters and thresholds, but share the side filter
+        for (auto *f: {&bands[i], &references[i]}) {
+            f->getBaseFilter().setFreq(250.f * static_cast<float>(i + 1));
+            f->getTargetFilter().setFreq(250.f * static_cast<float>(i + 1));
+            f->getCompressor().getComputer().setThreshold(-20.f - 5.f * static_cast<float>(i));
+        }
+    }
+
+    std::array<juce::AudioBuffer<float>, bandNum> mBuffers, mReferences;
+    for (size_t i = 0; i < bandNum; ++i) {
+        mBuffers[i].setSize(2, numSamples);
+        mReferences[i].setSize(2, numSamples);
+    }
+    juce::AudioBuffer<float> sBuffer(2, numSamples);
+    std::mt19937 gen(42);
+
+    // the bands which take the loudness of the first band match the bands which filter the side chain themselves
+    bool isSame = true;
+    for (int k = 0; k < 32; ++k) {
+        fillNoise(sBuffer, gen);
+        for (size_t i = 0; i < bandNum; ++i) {
+            fillNoise(mBuffers[i], gen);
+            mReferences[i].makeCopyOf(mBuffers[i]);
+            references[i].process(mReferences[i], sBuffer);
+            if (i == 0) {
+                bands[i].process(mBuffers[i], sBuffer);
+            } else {
+                bands[i].process(mBuffers[i], bands[0]);
+            }
+            for (int c = 0; c < 2; ++c) {
+                for (int j = 0; j < numSamples; ++j) {
+                    isSame = isSame && mBuffers[i].getReadPointer(c)[j] == mReferences[i].getReadPointer(c)[j];
+                }
+            }
+        }
+    }
+    CHECK(isSame);
+
+    BENCHMARK("4 dynamic bands, separate side chains") {
+        for (size_t i = 0; i < bandNum; ++i) {
+            references[i].process(mReferences[i], sBuffer);
+        }
+        return mReferences[0].getReadPointer(0)[0];
+    };
+
+    BENCHMARK("4 dynamic bands, shared side chain") {
+        bands[0].process(mBuffers[0], sBuffer);
+        for (size_t i = 1; i < bandNum; ++i) {
+            bands[i].process(mBuffers[i], bands[0]);
+        }
+        return mBuffers[0].getReadPointer(0)[0];
+    };
+}
+
+TEST_CASE("SpectralSideChain", "[side-chain]") {
+    constexpr int numSamples = 48;
+    constexpr size_t bandNum = zlDynamicFilter::SpectralSideChain<float>::maxBands;
+    constexpr size_t momentarySize = 480;
+    const juce::dsp::ProcessSpec spec{48000, numSamples, 2};
+    zlDynamicFilter::SpectralSideChain<float> spectral;
+    spectral.prepare(spec, momentarySize);
+    std::array<zlIIR::Filter<float>, bandNum> sideFilters;
+    std::array<juce::AudioBuffer<float>, bandNum> sideBuffers;
+    std::array<zlCompressor::RMSTracker<float>, bandNum> trackers;
+    for (size_t i = 0; i < bandNum; ++i) {
+        setSideFilter(sideFilters[i], spec);
+        sideFilters[i].setFreq(static_cast<float>(62.5 * std::pow(2.0, static_cast<double>(i) * 0.5)));
+        sideFilters[i].updateParas();
+        spectral.setBand(i, sideFilters[i], true);
+        sideBuffers[i].setSize(2, numSamples);
+        trackers[i].setMaximumMomentarySize(momentarySize / numSamples);
+        trackers[i].prepare(spec);
+        trackers[i].setMomentarySize(momentarySize / numSamples);
+    }
+
+    // a 1 kHz sine is estimated as the band-pass filters and the trackers do, on the whole grid
+    juce::AudioBuffer<float> sBuffer(2, numSamples);
+    double phase = 0;
+    for (int k = 0; k < 100; ++k) {
+        for (int j = 0; j < numSamples; ++j) {
+            const auto x = static_cast<float>(0.5 * std::sin(phase));
+            phase += 2 * std::numbers::pi * 1000.0 / 48000.0;
+            sBuffer.getWritePointer(0)[j] = x;
+            sBuffer.getWritePointer(1)[j] = x;
+        }
+        spectral.process(sBuffer, momentarySize);
+    }
+    for (size_t i = 0; i < bandNum; ++i) {
+        // -6.02 dB is the loudness of the sine summed over two channels
+        const auto gain = zlIIR::ResponseEngine::getGain(sideFilters[i].getCoeffs(), sideFilters[i].getFilterNum(),
+                                                         48000.0, 1000.0);
+        const auto expected = 10 * std::log10(0.25) + 20 * std::log10(gain);
+        INFO("band at " << sideFilters[i].getFreq() << " Hz");
+        CHECK(std::abs(static_cast<double>(spectral.getLoudness(i)) - expected) < 0.25);
+    }
+
+    BENCHMARK("16 side filters and trackers") {
+        for (size_t i = 0; i < bandNum; ++i) {
+            sideFilters[i].processTo(juce::dsp::AudioBlock<const float>(sBuffer),
+                                     juce::dsp::AudioBlock<float>(sideBuffers[i]));
+            trackers[i].process(sideBuffers[i]);
+        }
+        return trackers[0].getMomentaryLoudness();
+    };
+
+    BENCHMARK("16 bands in one spectral side chain") {
+        spectral.process(sBuffer, momentarySize);
+        return spectral.getLoudness(0);
+    };
+}
+
+TEST_CASE("RMSTracker", "[side-chain]") {
+    constexpr int numSamples = 48;
+    const juce::dsp::ProcessSpec spec{48000, numSamples, 2};
+    zlCompressor::RMSTracker<float> tracker;
+    tracker.setMaximumMomentarySize(400);
+    tracker.prepare(spec);
+    juce::AudioBuffer<float> buffer(2, numSamples);
+    std::mt19937 gen(42);
+    std::deque<double> references;
+
+    // loud blocks followed by quiet ones, the running sum must not keep the rounding errors of the loud blocks
+    bool isClose = true;
+    for (const auto &[size, gain, blockNum]: std::vector<std::tuple<size_t, float, int> >{
+             {100, 1.f, 5000}, {100, 1e-4f, 5000}, {400, 1e-2f, 3000}, {37, 1e-5f, 3000}, {400, 1.f, 1000}
+         }) {
+        tracker.setMomentarySize(size);
+        for (int k = 0; k < blockNum; ++k) {
+            fillNoise(buffer, gen);
+            buffer.applyGain(gain);
+            tracker.process(buffer);
+            double meanSquare = 0;
+            for (int c = 0; c < 2; ++c) {
+                for (int j = 0; j < numSamples; ++j) {
+                    meanSquare += static_cast<double>(buffer.getReadPointer(c)[j]) * buffer.getReadPointer(c)[j];
+                }
+            }
+            references.push_back(meanSquare / numSamples);
+            while (references.size() > size) { references.pop_front(); }
+            const auto expected = 10 * std::log10(std::accumulate(references.begin(), references.end(), 0.0) /
+                                                  static_cast<double>(size));
+            isClose = isClose && std::abs(static_cast<double>(tracker.getMomentaryLoudness()) - expected) < 1e-3;
+        }
+    }
+    CHECK(isClose);
+
+    BENCHMARK("RMS tracker, 48 samples") {
+        tracker.process(buffer);
+        return tracker.getMomentaryLoudness();
+    };
+}
+
+TEST_CASE("RouteTracker", "[side-chain]") {
+    constexpr int numSamples = 48;
+    const juce::dsp::ProcessSpec spec{48000, numSamples, 2};
+    juce::AudioBuffer<float> buffer(2, numSamples);
+    std::mt19937 gen(42);
+    zlSplitter::LRSplitter<float> lrSplitter;
+    zlSplitter::MSSplitter<float> msSplitter;
+    lrSplitter.prepare(spec);
+    msSplitter.prepare(spec);
+
+    // correlated channels, so that the mid and the side differ
+    const auto fillCorrelated = [&]() {
+        fillNoise(buffer, gen);
+        auto *l = buffer.getWritePointer(0);
+        auto *r = buffer.getWritePointer(1);
+        for (int i = 0; i < numSamples; ++i) {
+            r[i] = 0.7f * l[i] + 0.3f * r[i];
+        }
+    };
+    const auto getSplitMeanSquares = [&]() {
+        lrSplitter.split(buffer);
+        msSplitter.split(buffer);
+        using tracker = zlCompressor::RMSTracker<float>;
+        return std::array<float, 5>{
+            tracker::getMeanSquare(juce::dsp::AudioBlock<const float>(buffer)),
+            tracker::getMeanSquare(juce::dsp::AudioBlock<const float>(lrSplitter.getLBuffer())),
+            tracker::getMeanSquare(juce::dsp::AudioBlock<const float>(lrSplitter.getRBuffer())),
+            tracker::getMeanSquare(juce::dsp::AudioBlock<const float>(msSplitter.getMBuffer())),
+            tracker::getMeanSquare(juce::dsp::AudioBlock<const float>(msSplitter.getSBuffer()))
+        };
+    };
+
+    bool isClose = true;
+    for (int k = 0; k < 1000; ++k) {
+        fillCorrelated();
+        const auto fused = zlCompressor::RouteTracker<float>::getMeanSquares(
+            juce::dsp::AudioBlock<const float>(buffer));
+        const auto split = getSplitMeanSquares();
+        for (size_t i = 0; i < fused.size(); ++i) {
+            isClose = isClose && std::abs(fused[i] - split[i]) <= 1e-5f * std::max(split[i], 1e-3f);
+        }
+    }
+    CHECK(isClose);
+
+    fillCorrelated();
+    BENCHMARK("5 routes, split buffers") {
+        return getSplitMeanSquares();
+    };
+    BENCHMARK("5 routes, one pass") {
+        return zlCompressor::RouteTracker<float>::getMeanSquares(juce::dsp::AudioBlock<const float>(buffer));
+    };
+}
@@ -1,11 +1,25 @@
-file(GLOB_RECURSE BenchmarkFiles CONFIGURE_DEPENDS "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/*.cpp" "${CMAKE_CURRENT_SOURCE_DIR}/Benchmarks/*.h")
+# Required for ctest, see Tests.cmake
+enable_testing()
 
-# Organize the test source in the Tests/ folder in the IDE
+file(GLOB_RECURSE BenchmarkFiles CONFIGURE_DEPENDS "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/*.cpp" "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/*.hpp")
+
+# Organize the benchmark source in the benchmarks/ folder in the IDE
 source_group(TREE ${CMAKE_CURRENT_SOURCE_DIR}/benchmarks PREFIX "" FILES ${BenchmarkFiles})
 
+# Use Catch2 v3 (with its benchmarking support), unless the Tests target has already fetched it
+if (NOT TARGET Catch2::Catch2WithMain)
+    Include(FetchContent)
+    FetchContent_Declare(
+        Catch2
+        GIT_REPOSITORY https://github.com/catchorg/Catch2.git
+        GIT_PROGRESS TRUE
+        GIT_SHALLOW TRUE
+        GIT_TAG v3.4.0)
+    FetchContent_MakeAvailable(Catch2)
+endif ()
+
 add_executable(Benchmarks ${BenchmarkFiles})
 target_compile_features(Benchmarks PRIVATE cxx_std_20)
-catch_discover_tests(Benchmarks)
 
 # Our benchmark executable also wants to know about our plugin code...
 target_include_directories(Benchmarks PRIVATE ${CMAKE_CURRENT_SOURCE_DIR}/source)
@@ -24,3 +38,7 @@ target_compile_definitions(Benchmarks PUBLIC
     JUCE_MODAL_LOOPS_PERMITTED=1 # let us run Message Manager in tests
     RUN_PAMPLEJUCE_TESTS=1 # also run tests in module .cpp files guarded by RUN_PAMPLEJUCE_TESTS
 )
+
+# Each benchmark also checks its accuracy, so run them with ctest as well
+include(${Catch2_SOURCE_DIR}/extras/Catch.cmake)
+catch_discover_tests(Benchmarks)
@@ -0,0 +1,11 @@
+# An offline tool that compiles saved plugin states into static cascades, see source/dsp/preset
+add_executable(PresetCompiler "${CMAKE_CURRENT_SOURCE_DIR}/tools/preset_compiler/main.cpp")
+target_compile_features(PresetCompiler PRIVATE cxx_std_20)
+
+# The tool uses the plugin code (the filter design and the state format)
+target_include_directories(PresetCompiler PRIVATE ${CMAKE_CURRENT_SOURCE_DIR}/source)
+
+# Copy over compile definitions from our plugin target so it has all the JUCEy goodness
+target_compile_definitions(PresetCompiler PRIVATE $<TARGET_PROPERTY:${PROJECT_NAME},COMPILE_DEFINITIONS>)
+
+target_link_libraries(PresetCompiler PRIVATE SharedCode)
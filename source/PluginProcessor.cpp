@@ -30,7 +30,13 @@ PluginProcessor::PluginProcessor()
       filtersAttach(*this, parameters, parametersNA, controller),
       soloAttach(*this, parameters, controller),
       choreAttach(*this, parameters, parametersNA, controller),
-      resetAttach(*this, parameters, parametersNA, controller) {
+      resetAttach(*this, parameters, parametersNA, controller),
+      floatController(*this),
+      floatFiltersAttach(*this, parameters, parametersNA, floatController),
+      floatSoloAttach(*this, parameters, floatController),
+      floatChoreAttach(*this, parameters, parametersNA, floatController),
+      floatResetAttach(*this, parameters, parametersNA, floatController),
+      precision(*parameters.getRawParameterValue(zlDSP::precision::ID)) {
 }
 
 PluginProcessor::~PluginProcessor() = default;
@@ -65,7 +71,7 @@ bool PluginProcessor::isMidiEffect() const {
 }
 
 double PluginProcessor::getTailLengthSeconds() const {
-    return 0.0;
+    return getUseFloat() ? floatController.getTailSeconds() : controller.getTailSeconds();
 }
 
 int PluginProcessor::getNumPrograms() {
@@ -105,7 +111,10 @@ void PluginProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
         2
     };
     doubleBuffer.setSize(4, samplesPerBlock);
+    floatBuffer.setSize(4, samplesPerBlock);
+    silentSamples = 0;
     controller.prepare(spec);
+    floatController.prepare(spec);
 }
 
 void PluginProcessor::releaseResources() {
@@ -133,6 +142,24 @@ void PluginProcessor::processBlock(juce::AudioBuffer<float> &buffer,
                                    juce::MidiBuffer &midiMessages) {
     juce::ignoreUnused(midiMessages);
     juce::ScopedNoDenormals noDenormals;
+    const auto useFloat = getUseFloat();
+    if (useFloat != currentUseFloat) {
+        // the controller that resumes processing holds the states of its last block
+        currentUseFloat = useFloat;
+        if (currentUseFloat) {
+            floatController.setToRest();
+        } else {
+            controller.setToRest();
+        }
+    }
+    if (isTailSilent(buffer)) {
+        buffer.clear();
+        return;
+    }
+    if (currentUseFloat) {
+        processFloat(buffer);
+        return;
+    }
     const auto mINum = mainInChannelNum.load();
     const auto aINum = auxInChannelNum.load();
     if (mINum == 1 && aINum == 1) {
@@ -188,9 +215,41 @@ void PluginProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     }
 }
 
+void PluginProcessor::processFloat(juce::AudioBuffer<float> &buffer) {
+    const auto mINum = mainInChannelNum.load();
+    const auto aINum = auxInChannelNum.load();
+    const auto numSamples = buffer.getNumSamples();
+    if (mINum == 1 && aINum == 1) {
+        floatBuffer.setSize(4, numSamples, false, false, true);
+        for (int chan = 0; chan < 4; ++chan) {
+            juce::FloatVectorOperations::copy(floatBuffer.getWritePointer(chan),
+                                              buffer.getReadPointer(chan / 2), numSamples);
+        }
+        floatController.process(floatBuffer);
+        juce::FloatVectorOperations::copy(buffer.getWritePointer(0), floatBuffer.getReadPointer(0), numSamples);
+    } else if (mINum == 2 && aINum == 1) {
+        floatBuffer.setSize(4, numSamples, false, false, true);
+        for (int chan = 0; chan < 4; ++chan) {
+            juce::FloatVectorOperations::copy(floatBuffer.getWritePointer(chan),
+                                              buffer.getReadPointer(std::min(chan, 2)), numSamples);
+        }
+        floatController.process(floatBuffer);
+        for (int chan = 0; chan < 2; ++chan) {
+            juce::FloatVectorOperations::copy(buffer.getWritePointer(chan), floatBuffer.getReadPointer(chan),
+                                              numSamples);
+        }
+    } else if (mINum == 2 && aINum == 2) {
+        floatController.process(buffer);
+    }
+}
+
 void PluginProcessor::processBlock(juce::AudioBuffer<double> &buffer, juce::MidiBuffer &midiMessages) {
     juce::ignoreUnused(midiMessages);
     juce::ScopedNoDenormals noDenormals;
+    if (isTailSilent(buffer)) {
+        buffer.clear();
+        return;
+    }
     const auto mINum = mainInChannelNum.load();
     const auto aINum = auxInChannelNum.load();
     if (mINum == 1 && aINum == 1) {
@@ -238,9 +297,27 @@ void PluginProcessor::processBlock(juce::AudioBuffer<double> &buffer, juce::Midi
     }
 }
 
+template<typename FloatType>
+bool PluginProcessor::isTailSilent(const juce::AudioBuffer<FloatType> &buffer) {
+    const auto numSamples = buffer.getNumSamples();
+    if (buffer.getMagnitude(0, numSamples) >= zlIIR::Filter<FloatType>::idleThreshold) {
+        silentSamples = 0;
+        return false;
+    }
+    // the output of this block only depends on the input which is older than the silent part
+    const auto tailSamples = static_cast<juce::int64>(std::ceil(getTailLengthSeconds() * getSampleRate()));
+    const auto isSkipped = silentSamples >= tailSamples;
+    silentSamples += numSamples;
+    return isSkipped;
+}
+
 void PluginProcessor::processBlockBypassed(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midiMessages) {
     juce::ignoreUnused(buffer, midiMessages);
-    controller.processBypass();
+    if (currentUseFloat) {
+        floatController.processBypass();
+    } else {
+        controller.processBypass();
+    }
 }
 
 void PluginProcessor::processBlockBypassed(juce::AudioBuffer<double> &buffer, juce::MidiBuffer &midiMessages) {
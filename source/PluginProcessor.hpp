@@ -73,7 +73,22 @@ public:
 
     bool supportsDoublePrecisionProcessing() const override { return true; }
 
-    inline zlDSP::Controller<double>& getController() {return controller;}
+    template<typename FloatType = double>
+    inline zlDSP::Controller<FloatType>& getController() {
+        if constexpr (std::is_same_v<FloatType, float>) {
+            return floatController;
+        } else {
+            return controller;
+        }
+    }
+
+    /**
+     * @return whether the float controller processes the audio, i.e. the float precision is selected
+     * and the host supplies float buffers
+     */
+    bool getUseFloat() const {
+        return static_cast<size_t>(precision.load()) == 1 && !isUsingDoublePrecision();
+    }
 
 private:
     zlDSP::Controller<double> controller;
@@ -82,8 +97,28 @@ private:
     zlDSP::ChoreAttach<double> choreAttach;
     zlDSP::ResetAttach<double> resetAttach;
     juce::AudioBuffer<double> doubleBuffer;
+    zlDSP::Controller<float> floatController;
+    zlDSP::FiltersAttach<float> floatFiltersAttach;
+    zlDSP::SoloAttach<float> floatSoloAttach;
+    zlDSP::ChoreAttach<float> floatChoreAttach;
+    zlDSP::ResetAttach<float> floatResetAttach;
+    juce::AudioBuffer<float> floatBuffer;
+    std::atomic<float> &precision;
+    bool currentUseFloat{false};
     std::atomic<bool> isMono{false};
     std::atomic<int> mainInChannelNum{2}, auxInChannelNum{2};
+    juce::int64 silentSamples{0};
+
+    void processFloat(juce::AudioBuffer<float> &buffer);
+
+    /**
+     * update the length of the silent input and check whether the tail has decayed to silence
+     * if so, the controller can be skipped and the output is silent
+     * @param buffer
+     * @return whether the block can be skipped
+     */
+    template<typename FloatType>
+    bool isTailSilent(const juce::AudioBuffer<FloatType> &buffer);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginProcessor)
 };
@@ -26,8 +26,19 @@ namespace zlAudioBuffer {
     }
 
     template<typename FloatType>
-    void FixedAudioBuffer<FloatType>::setSubBufferSize(int subBufferSize) {
+    void FixedAudioBuffer<FloatType>::reset() {
         clear();
+        // subBuffer holds at least one sub buffer of zeros now
+        if (subSize > 1) {
+            inputBuffer.push(subBuffer, subSize);
+        }
+    }
+
+    template<typename FloatType>
+    void FixedAudioBuffer<FloatType>::setSubBufferSize(int subBufferSize, int maxNumSubBuffers) {
+        clear();
+        subSize = std::max(subBufferSize, 1);
+        maxSubNum = std::max(maxNumSubBuffers, 1);
         // init internal spec
         subSpec = mainSpec;
         subSpec.maximumBlockSize = static_cast<juce::uint32>(subBufferSize);
@@ -37,8 +48,11 @@ namespace zlAudioBuffer {
             latencyInSamples.store(0);
         }
         // resize subBuffer, inputBuffer and outputBuffer
+        // subBuffer is allocated for maxSubNum sub buffers, and shrinks to one sub buffer without reallocating
         subBuffer.setSize(static_cast<int>(subSpec.numChannels),
-                          static_cast<int>(subSpec.maximumBlockSize));
+                          static_cast<int>(subSpec.maximumBlockSize) * maxSubNum);
+        subBuffer.setSize(static_cast<int>(subSpec.numChannels),
+                          static_cast<int>(subSpec.maximumBlockSize), false, false, true);
         inputBuffer.setSize(static_cast<int>(mainSpec.numChannels),
                             static_cast<int>(mainSpec.maximumBlockSize) + subBufferSize);
         outputBuffer.setSize(static_cast<int>(mainSpec.numChannels),
@@ -73,6 +87,13 @@ namespace zlAudioBuffer {
 
     template<typename FloatType>
     void FixedAudioBuffer<FloatType>::popSubBuffer() {
+        popSubBuffers(1);
+    }
+
+    template<typename FloatType>
+    void FixedAudioBuffer<FloatType>::popSubBuffers(const int numSubBuffers) {
+        jassert(numSubBuffers >= 1 && numSubBuffers <= maxSubNum);
+        subBuffer.setSize(static_cast<int>(subSpec.numChannels), subSize * numSubBuffers, false, false, true);
         inputBuffer.pop(subBuffer);
     }
 
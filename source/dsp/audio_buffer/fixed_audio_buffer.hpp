@@ -24,7 +24,17 @@ namespace zlAudioBuffer {
 
         void clear();
 
-        void setSubBufferSize(int subBufferSize);
+        /**
+         * clear the samples and refill the latency samples with zeros, it does not allocate
+         */
+        void reset();
+
+        /**
+         * set the size of a sub buffer
+         * @param subBufferSize
+         * @param maxNumSubBuffers the maximum number of sub buffers that can be popped at once
+         */
+        void setSubBufferSize(int subBufferSize, int maxNumSubBuffers = 1);
 
         void prepare(juce::dsp::ProcessSpec spec);
 
@@ -34,6 +44,12 @@ namespace zlAudioBuffer {
 
         void popSubBuffer();
 
+        /**
+         * pop several sub buffers into subBuffer at once, the latency stays the same
+         * @param numSubBuffers must not exceed getNumSubReady() or getMaxNumSubBuffers()
+         */
+        void popSubBuffers(int numSubBuffers);
+
         void pushSubBuffer();
 
         void popBuffer(juce::AudioBuffer<FloatType> &buffer, bool write = true);
@@ -45,13 +61,28 @@ namespace zlAudioBuffer {
         juce::dsp::AudioBlock<FloatType> getSubBlockChannels(int channelOffset, int numChannels);
 
         inline auto isSubReady() {
-            return inputBuffer.getNumReady() >= subBuffer.getNumSamples();
+            return inputBuffer.getNumReady() >= subSize;
+        }
+
+        inline int getNumSubReady() {
+            return inputBuffer.getNumReady() / subSize;
         }
 
+        inline int getMaxNumSubBuffers() const { return maxSubNum; }
+
         inline auto getMainSpec() { return mainSpec; }
 
         inline auto getSubSpec() { return subSpec; }
 
+        /**
+         * @return the spec of the largest block subBuffer can hold
+         */
+        inline auto getMaxSubSpec() {
+            auto spec = subSpec;
+            spec.maximumBlockSize *= static_cast<juce::uint32>(maxSubNum);
+            return spec;
+        }
+
         inline juce::uint32 getLatencySamples() {
             return static_cast<juce::uint32>(latencyInSamples.load());
         }
@@ -60,6 +91,7 @@ namespace zlAudioBuffer {
         FIFOAudioBuffer<FloatType> inputBuffer, outputBuffer;
         juce::dsp::ProcessSpec subSpec, mainSpec;
         std::atomic<juce::uint32> latencyInSamples{0};
+        int subSize{1}, maxSubNum{1};
     };
 }
 
@@ -78,16 +78,20 @@ namespace zlDSP {
         } else if (parameterID == outputGain::ID) {
             controllerRef.getGainDSP().setGainDecibels(static_cast<FloatType>(newValue));
         } else if (parameterID == filterStructure::ID) {
+            const auto structure = static_cast<size_t>(newValue);
             for (size_t i = 0; i < bandNUM; ++i) {
-                controllerRef.getFilter(i).setSVFON(static_cast<bool>(newValue));
+                controllerRef.getFilter(i).setSVFON(structure == 1);
             }
-            controllerRef.getSoloFilter().setSVFON(static_cast<bool>(newValue));
+            controllerRef.getSoloFilter().setSVFON(structure == 1);
+            controllerRef.setParallelON(structure == 2);
         } else if (parameterID == dynLink::ID) {
             controllerRef.setDynLink(static_cast<bool>(newValue));
         } else if (parameterID == dynHQ::ID) {
             for (size_t i = 0; i < bandNUM; ++i) {
                 controllerRef.getFilter(i).setIsPerSample(static_cast<bool>(newValue));
             }
+        } else if (parameterID == dynSpectral::ID) {
+            controllerRef.setSpectralON(static_cast<bool>(newValue));
         } else if (parameterID == zeroLatency::ID) {
             controllerRef.setZeroLatency(static_cast<bool>(newValue));
         } else if (parameterID == zlState::fftPreON::ID) {
@@ -23,12 +23,17 @@ namespace zlCompressor {
     }
 
     template<typename FloatType>
-    FloatType ForwardCompressor<FloatType>::process(juce::AudioBuffer<FloatType> buffer) {
-        tracker.process(buffer);
-        auto x = tracker.getMomentaryLoudness() - baseLine.load();
+    FloatType ForwardCompressor<FloatType>::process(const juce::dsp::AudioBlock<const FloatType> &block) {
+        tracker.process(block);
+        return process(tracker.getMomentaryLoudness(), static_cast<int>(block.getNumSamples()));
+    }
+
+    template<typename FloatType>
+    FloatType ForwardCompressor<FloatType>::process(const FloatType loudness, const int numSamples) {
+        auto x = loudness - baseLine.load();
         x = computer.process(x);
         x = juce::Decibels::decibelsToGain(x);
-        detector.setBufferSize(buffer.getNumSamples());
+        detector.setBufferSize(numSamples);
         x = detector.process(x);
         return x;
     }
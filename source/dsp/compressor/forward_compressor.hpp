@@ -31,11 +31,20 @@ namespace zlCompressor {
         void prepare(const juce::dsp::ProcessSpec &spec);
 
         /**
-         * process the audio buffer and return the compression gain (in gain)
-         * @param buffer side chain audio buffer
+         * process the audio block and return the compression gain (in gain)
+         * @param block side chain audio block, it is only read
          * @return gain (in gain)
          */
-        FloatType process(juce::AudioBuffer<FloatType> buffer);
+        FloatType process(const juce::dsp::AudioBlock<const FloatType> &block);
+
+        /**
+         * process the momentary loudness of a side chain which has been tracked elsewhere
+         * and return the compression gain (in gain), the tracker of this compressor is not updated
+         * @param loudness momentary loudness (in dB)
+         * @param numSamples the number of samples of the block
+         * @return gain (in gain)
+         */
+        FloatType process(FloatType loudness, int numSamples);
 
         inline KneeComputer<FloatType> &getComputer() { return computer; }
 
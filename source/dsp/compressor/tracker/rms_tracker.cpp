@@ -10,15 +10,14 @@
 #include "rms_tracker.hpp"
 
 namespace zlCompressor {
-    template<typename FloatType>
-    RMSTracker<FloatType>::~RMSTracker() {
-        loudnessBuffer.clear();
-    }
-
     template<typename FloatType>
     void RMSTracker<FloatType>::reset() {
-        mLoudness.store(0);
-        loudnessBuffer.clear();
+        writePos = 0;
+        num = 0;
+        pushNum = 0;
+        sum = 0;
+        peakSum = 0;
+        mLoudness.store(minusInfinityDB);
     }
 
     template<typename FloatType>
@@ -30,24 +29,76 @@ namespace zlCompressor {
 
     template<typename FloatType>
     void RMSTracker<FloatType>::process(const juce::AudioBuffer<FloatType> &buffer) {
-        // calculate mean square
-        FloatType _ms = 0;
-        for (auto channel = 0; channel < buffer.getNumChannels(); channel++) {
-            auto data = buffer.getReadPointer(channel);
-            for (auto i = 0; i < buffer.getNumSamples(); i++) {
-                _ms += data[i] * data[i];
-            }
+        process(juce::dsp::AudioBlock<const FloatType>(buffer));
+    }
+
+    template<typename FloatType>
+    void RMSTracker<FloatType>::process(const juce::dsp::AudioBlock<const FloatType> &block) {
+        processMeanSquare(getMeanSquare(block));
+    }
+
+    template<typename FloatType>
+    void RMSTracker<FloatType>::processMeanSquare(const FloatType _ms) {
+        bool toUpdate = false;
+        const auto nextWindow = std::min(currentSize.load(), capacity);
+        if (nextWindow != window) {
+            window = nextWindow;
+            num = std::min(num, window);
+            toUpdate = true;
+        }
+        // drop the mean square which leaves the window, it is the one overwritten if the window is full
+        if (num == window) {
+            sum -= static_cast<double>(ring[(writePos + capacity - window) % capacity]);
+        } else {
+            num += 1;
+        }
+        ring[writePos] = _ms;
+        sum += static_cast<double>(_ms);
+        peakSum = std::max(peakSum, sum);
+        writePos = (writePos + 1) % capacity;
+
+        pushNum += 1;
+        if (toUpdate || pushNum >= window || sum < peakSum * cancellationRatio) {
+            updateSum();
         }
 
-        _ms = _ms / static_cast<FloatType>(buffer.getNumSamples());
+        const auto meanSquare = static_cast<FloatType>(std::max(sum, 0.0) / static_cast<double>(window));
+        mLoudness.store(juce::Decibels::gainToDecibels(meanSquare, minusInfinityDB * 2) * static_cast<FloatType>(0.5));
+    }
 
-        while (loudnessBuffer.size() >= currentSize.load()) {
-            mLoudness.store(mLoudness.load() - loudnessBuffer.front());
-            loudnessBuffer.pop_front();
+    template<typename FloatType>
+    void RMSTracker<FloatType>::updateSum() {
+        sum = 0;
+        for (size_t i = 0, pos = writePos; i < num; ++i) {
+            pos = pos == 0 ? capacity - 1 : pos - 1;
+            sum += static_cast<double>(ring[pos]);
         }
+        peakSum = sum;
+        pushNum = 0;
+    }
 
-        loudnessBuffer.push_back(_ms);
-        mLoudness.store(mLoudness.load() + _ms);
+    template<typename FloatType>
+    FloatType RMSTracker<FloatType>::getMeanSquare(const juce::dsp::AudioBlock<const FloatType> &block) {
+        // independent accumulators break the dependency chain of the sum, so the loop is vectorized
+        std::array<FloatType, laneNum> acc{};
+        const auto numSamples = block.getNumSamples();
+        for (size_t channel = 0; channel < block.getNumChannels(); channel++) {
+            const auto *data = block.getChannelPointer(channel);
+            size_t i = 0;
+            for (; i + laneNum <= numSamples; i += laneNum) {
+                for (size_t j = 0; j < laneNum; ++j) {
+                    acc[j] += data[i + j] * data[i + j];
+                }
+            }
+            for (; i < numSamples; ++i) {
+                acc[0] += data[i] * data[i];
+            }
+        }
+        FloatType _ms = 0;
+        for (const auto &a: acc) {
+            _ms += a;
+        }
+        return numSamples == 0 ? FloatType(0) : _ms / static_cast<FloatType>(numSamples);
     }
 
     template<typename FloatType>
@@ -65,13 +116,13 @@ namespace zlCompressor {
     template<typename FloatType>
     void RMSTracker<FloatType>::setMaximumMomentarySize(size_t mSize) {
         mSize = std::max(static_cast<size_t>(1), mSize);
-        loudnessBuffer.set_capacity(mSize);
-    }
-
-    template<typename FloatType>
-    FloatType RMSTracker<FloatType>::getMomentaryLoudness() {
-        FloatType meanSquare = mLoudness.load() / static_cast<FloatType>(currentSize.load());
-        return juce::Decibels::gainToDecibels(meanSquare, minusInfinityDB * 2) * static_cast<FloatType>(0.5);
+        if (mSize != capacity) {
+            ringData.allocate(mSize * sizeof(FloatType) + alignment, true);
+            ring = juce::snapPointerToAlignment(reinterpret_cast<FloatType *>(ringData.get()), alignment);
+            capacity = mSize;
+            window = std::min(window, capacity);
+        }
+        reset();
     }
 
     template
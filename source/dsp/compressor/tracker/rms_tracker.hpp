@@ -10,12 +10,16 @@
 #ifndef ZLECOMP_RMS_TRACKER_H
 #define ZLECOMP_RMS_TRACKER_H
 
-#include <boost/circular_buffer.hpp>
 #include <juce_dsp/juce_dsp.h>
 
 namespace zlCompressor {
     /**
      * a tracker that tracks the momentary RMS loudness of the audio signal
+     * the mean squares of the latest blocks are kept in a fixed-capacity ring owned by the audio thread,
+     * its running sum is recomputed exactly once per window so that rounding errors do not accumulate,
+     * and whenever it falls far below its peak, where the cancellation would leave the errors of the loud blocks
+     * (a compensated sum would not survive -Ofast, which reassociates it away)
+     * only the loudness is published atomically
      * @tparam FloatType
      */
     template<typename FloatType>
@@ -23,9 +27,10 @@ namespace zlCompressor {
     public:
         inline static FloatType minusInfinityDB = -240;
 
-        RMSTracker() = default;
+        /** the number of accumulators of the mean square kernel, they are mapped onto SIMD registers */
+        static constexpr size_t laneNum = 8;
 
-        ~RMSTracker();
+        RMSTracker() { setMaximumMomentarySize(1); }
 
         void reset();
 
@@ -33,27 +38,57 @@ namespace zlCompressor {
 
         void process(const juce::AudioBuffer<FloatType> &buffer);
 
+        void process(const juce::dsp::AudioBlock<const FloatType> &block);
+
+        /**
+         * push the mean square of a block which has been computed elsewhere
+         * @param meanSquare
+         */
+        void processMeanSquare(FloatType meanSquare);
+
         void setMomentarySeconds(FloatType x);
 
         void setMomentarySize(size_t mSize);
 
+        /**
+         * set the capacity of the ring, call it off the audio thread since it allocates
+         * @param mSize
+         */
         void setMaximumMomentarySize(size_t mSize);
 
         inline size_t getMomentarySize() const {
             return currentSize.load();
         }
 
-        FloatType getMomentaryLoudness();
+        inline FloatType getMomentaryLoudness() const {
+            return mLoudness.load();
+        }
+
+        /**
+         * get the mean square of a block, the squares of all channels are summed
+         * @param block
+         * @return
+         */
+        static FloatType getMeanSquare(const juce::dsp::AudioBlock<const FloatType> &block);
 
     private:
-        std::atomic<FloatType> mLoudness {0};
-        boost::circular_buffer<FloatType> loudnessBuffer{1};
+        std::atomic<FloatType> mLoudness{minusInfinityDB};
+
+        static constexpr size_t alignment = 64;
+        juce::HeapBlock<char> ringData;
+        FloatType *ring{nullptr};
+        size_t capacity{0};
+        size_t writePos{0}, num{0}, window{1}, pushNum{0};
+        double sum{0}, peakSum{0};
+        static constexpr double cancellationRatio = 1e-8;
 
         std::atomic<double> sampleRate{44100};
         std::atomic<FloatType> currentSeconds{0};
         std::atomic<size_t> currentSize{1};
+
+        void updateSum();
     };
 
 } // zldetector
 
-#endif //ZLECOMP_RMS_TRACKER_H
\ No newline at end of file
+#endif //ZLECOMP_RMS_TRACKER_H
@@ -0,0 +1,84 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include "route_tracker.hpp"
+
+namespace zlCompressor {
+    template<typename FloatType>
+    void RouteTracker<FloatType>::reset() {
+        for (auto &t: trackers) {
+            t.reset();
+        }
+    }
+
+    template<typename FloatType>
+    void RouteTracker<FloatType>::prepare(const juce::dsp::ProcessSpec &spec) {
+        for (auto &t: trackers) {
+            t.prepare(spec);
+        }
+    }
+
+    template<typename FloatType>
+    void RouteTracker<FloatType>::process(const juce::dsp::AudioBlock<const FloatType> &block,
+                                          const std::array<bool, routeNum> &isON) {
+        if (std::none_of(isON.begin(), isON.end(), [](const bool x) { return x; })) { return; }
+        const auto meanSquares = getMeanSquares(block);
+        for (size_t i = 0; i < routeNum; ++i) {
+            if (isON[i]) {
+                trackers[i].processMeanSquare(meanSquares[i]);
+            }
+        }
+    }
+
+    template<typename FloatType>
+    std::array<FloatType, RouteTracker<FloatType>::routeNum> RouteTracker<FloatType>::getMeanSquares(
+        const juce::dsp::AudioBlock<const FloatType> &block) {
+        jassert(block.getNumChannels() == 2);
+        if (block.getNumSamples() == 0) { return {}; }
+        // independent accumulators break the dependency chains of the sums, so the loop is vectorized
+        constexpr auto laneNum = RMSTracker<FloatType>::laneNum;
+        std::array<FloatType, laneNum> ll{}, rr{}, lr{};
+        const auto numSamples = block.getNumSamples();
+        const auto *lData = block.getChannelPointer(0);
+        const auto *rData = block.getChannelPointer(1);
+        size_t i = 0;
+        for (; i + laneNum <= numSamples; i += laneNum) {
+            for (size_t j = 0; j < laneNum; ++j) {
+                ll[j] += lData[i + j] * lData[i + j];
+                rr[j] += rData[i + j] * rData[i + j];
+                lr[j] += lData[i + j] * rData[i + j];
+            }
+        }
+        for (; i < numSamples; ++i) {
+            ll[0] += lData[i] * lData[i];
+            rr[0] += rData[i] * rData[i];
+            lr[0] += lData[i] * rData[i];
+        }
+        FloatType lSum = 0, rSum = 0, lrSum = 0;
+        for (size_t j = 0; j < laneNum; ++j) {
+            lSum += ll[j];
+            rSum += rr[j];
+            lrSum += lr[j];
+        }
+        const auto scale = FloatType(1) / static_cast<FloatType>(numSamples);
+        const auto lMS = lSum * scale, rMS = rSum * scale, lrMS = lrSum * scale;
+        // M^2 = (L^2 + R^2 + 2LR) / 4, S^2 = (L^2 + R^2 - 2LR) / 4, the latter may round below zero
+        return {
+            lMS + rMS, lMS, rMS,
+            std::max(FloatType(0.25) * (lMS + rMS + 2 * lrMS), FloatType(0)),
+            std::max(FloatType(0.25) * (lMS + rMS - 2 * lrMS), FloatType(0))
+        };
+    }
+
+    template
+    class RouteTracker<float>;
+
+    template
+    class RouteTracker<double>;
+}
@@ -0,0 +1,63 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLECOMP_ROUTE_TRACKER_HPP
+#define ZLECOMP_ROUTE_TRACKER_HPP
+
+#include "rms_tracker.hpp"
+
+namespace zlCompressor {
+    /**
+     * trackers of the stereo, left, right, mid and side routes of a stereo side chain
+     * the mean squares of all routes come from a single pass over the side chain, which accumulates
+     * sum(L^2), sum(R^2) and sum(LR), since M^2 + S^2 = (L^2 + R^2) / 2 and M^2 - S^2 = LR
+     * (with M = (L + R) / 2 and S = (L - R) / 2, see MSSplitter), so no route needs a split buffer
+     * @tparam FloatType
+     */
+    template<typename FloatType>
+    class RouteTracker {
+    public:
+        /** the routes, in the order of zlDSP::lrType */
+        enum route {
+            stereo, left, right, mid, side, routeNum
+        };
+
+        RouteTracker() = default;
+
+        void reset();
+
+        void prepare(const juce::dsp::ProcessSpec &spec);
+
+        /**
+         * process the side chain block and update the trackers which are on
+         * @param block stereo side chain audio block, it is only read
+         * @param isON whether each route is tracked
+         */
+        void process(const juce::dsp::AudioBlock<const FloatType> &block,
+                     const std::array<bool, routeNum> &isON);
+
+        inline FloatType getMomentaryLoudness(const size_t idx) const {
+            return trackers[idx].getMomentaryLoudness();
+        }
+
+        inline RMSTracker<FloatType> &getTracker(const size_t idx) { return trackers[idx]; }
+
+        /**
+         * get the mean squares of all routes of a stereo block
+         * @param block
+         * @return
+         */
+        static std::array<FloatType, routeNum> getMeanSquares(const juce::dsp::AudioBlock<const FloatType> &block);
+
+    private:
+        std::array<RMSTracker<FloatType>, routeNum> trackers;
+    };
+}
+
+#endif //ZLECOMP_ROUTE_TRACKER_HPP
@@ -11,5 +11,6 @@
 #define ZLEQUALIZER_TRACKER_HPP
 
 #include "rms_tracker.hpp"
+#include "route_tracker.hpp"
 
 #endif //ZLEQUALIZER_TRACKER_HPP
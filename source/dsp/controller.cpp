@@ -13,6 +13,15 @@ namespace zlDSP {
     template<typename FloatType>
     Controller<FloatType>::Controller(juce::AudioProcessor &processor)
         : processorRef(processor) {
+        for (auto &f: filters) {
+            for (auto *filter: {&f.getMainFilter(), &f.getBaseFilter(), &f.getTargetFilter(), &f.getSideFilter()}) {
+                filter->setCoeffCache(&coeffCache);
+            }
+        }
+        soloFilter.setCoeffCache(&coeffCache);
+        for (auto &c: parallelCascades) {
+            parallelDesigner.addCascade(c);
+        }
     }
 
     template<typename FloatType>
@@ -27,7 +36,9 @@ namespace zlDSP {
     void Controller<FloatType>::prepare(const juce::dsp::ProcessSpec &spec) {
         delay.setMaximumDelayInSamples(static_cast<int>(
                                            zlDSP::dynLookahead::range.end / 1000.f * static_cast<float>(spec.
-                                               sampleRate)) + 1);
+                                               sampleRate)) + 1 +
+                                       zlDynamicFilter::SpectralSideChain<FloatType>::getLatencySamples(
+                                           spec.sampleRate));
         delay.prepare({spec.sampleRate, spec.maximumBlockSize, 2});
 
         subBuffer.prepare({spec.sampleRate, spec.maximumBlockSize, 4});
@@ -37,7 +48,7 @@ namespace zlDSP {
 
     template<typename FloatType>
     void Controller<FloatType>::updateSubBuffer() {
-        subBuffer.setSubBufferSize(static_cast<int>(subBufferLength * sampleRate.load()));
+        subBuffer.setSubBufferSize(static_cast<int>(subBufferLength * sampleRate.load()), blockSSSubBufferNUM);
 
         triggerAsyncUpdate();
 
@@ -46,8 +57,12 @@ namespace zlDSP {
         for (auto &f: filters) {
             f.getCompressor().getTracker().setMaximumMomentarySize(numRMS);
         }
+        for (auto &s: spectralSideChains) {
+            s.prepare({sampleRate.load(), subBuffer.getMaxSubSpec().maximumBlockSize, 2}, numRMS);
+        }
+        updateSpectralDelay();
 
-        juce::dsp::ProcessSpec subSpec{sampleRate.load(), subBuffer.getSubSpec().maximumBlockSize, 2};
+        juce::dsp::ProcessSpec subSpec{sampleRate.load(), subBuffer.getMaxSubSpec().maximumBlockSize, 2};
         for (auto &f: filters) {
             f.prepare(subSpec);
         }
@@ -62,8 +77,9 @@ namespace zlDSP {
         autoGain.prepare(subSpec);
         fftAnalyzezr.prepare(subSpec);
         conflictAnalyzer.prepare(subSpec);
-        for (auto &t: {&tracker, &lTracker, &rTracker, &mTracker, &sTracker}) {
-            t->prepare(subSpec);
+        routeTracker.prepare(subSpec);
+        for (auto &c: parallelCascades) {
+            c.prepare(subSpec);
         }
     }
 
@@ -71,16 +87,34 @@ namespace zlDSP {
     void Controller<FloatType>::process(juce::AudioBuffer<FloatType> &buffer) {
         juce::AudioBuffer<FloatType> mainBuffer{buffer.getArrayOfWritePointers() + 0, 2, buffer.getNumSamples()};
         juce::AudioBuffer<FloatType> sideBuffer{buffer.getArrayOfWritePointers() + 2, 2, buffer.getNumSamples()};
+        if (toReset.exchange(false)) {
+            resetStates();
+        }
         // if no side chain, copy the main buffer into the side buffer
         if (!sideChain.load()) {
             sideBuffer.makeCopyOf(mainBuffer, true);
         }
         // process lookahead
         delay.process(mainBuffer);
+        // the layout is rebuilt here, so that a change takes effect in the next block even if the message thread
+        // does not run between blocks (e.g., offline rendering)
+        if (toUpdateStaticBands.exchange(false)) {
+            updateStaticBands();
+        }
+        for (size_t i = 0; i < bandNUM; ++i) {
+            currentStaticBands.isActive[i] = filters[i].getActive();
+        }
+        updateBlockSS(buffer.getNumSamples());
+        updateTail();
+        prefetchCoeffs();
+        if (paraHoldBlocks > 0) {
+            paraHoldBlocks -= 1;
+        }
         if (isZeroLatency.load()) {
             int startSample = 0;
-            const int samplePerBuffer = static_cast<int>(subBuffer.getSubSpec().maximumBlockSize);
             while (startSample < buffer.getNumSamples()) {
+                const int samplePerBuffer = static_cast<int>(subBuffer.getSubSpec().maximumBlockSize) *
+                                            getNumSubBuffers();
                 const int actualNumSample = std::min(samplePerBuffer, buffer.getNumSamples() - startSample);
                 auto subMainBuffer = juce::AudioBuffer<FloatType>(mainBuffer.getArrayOfWritePointers(),
                                                                   2, startSample, actualNumSample);
@@ -94,7 +128,7 @@ namespace zlDSP {
             // ---------------- start sub buffer
             subBuffer.pushBlock(block);
             while (subBuffer.isSubReady()) {
-                subBuffer.popSubBuffer();
+                subBuffer.popSubBuffers(std::min(subBuffer.getNumSubReady(), getNumSubBuffers()));
                 // create main sub buffer and side sub buffer
                 auto subMainBuffer = juce::AudioBuffer<FloatType>(subBuffer.subBuffer.getArrayOfWritePointers() + 0,
                                                                   2, subBuffer.subBuffer.getNumSamples());
@@ -139,7 +173,7 @@ namespace zlDSP {
         if (soloSide.load()) {
             subMainBuffer.makeCopyOf(subSideBuffer, true);
         }
-        switch (filterLRs[soloIdx.load()].load()) {
+        switch (currentStaticBands.lrs[soloIdx.load()]) {
             case lrType::stereo: {
                 soloFilter.process(subMainBuffer);
                 break;
@@ -179,105 +213,126 @@ namespace zlDSP {
     void Controller<FloatType>::processDynamic(juce::AudioBuffer<FloatType> &subMainBuffer,
                                                juce::AudioBuffer<FloatType> &subSideBuffer) {
         autoGain.processPre(subMainBuffer);
-        // stereo filters process
-        FloatType baseLine = 0;
-        if (useTrackers[0].load()) {
-            tracker.process(subSideBuffer);
-            baseLine = tracker.getMomentaryLoudness();
-            if (baseLine <= tracker.minusInfinityDB + 1) {
-                baseLine = tracker.minusInfinityDB * FloatType(0.5);
+        cascadeON.fill(false);
+        sideSources.fill(bandNUM);
+        // the side filters and the trackers are idle in the spectral mode, reset them when switching back
+        const auto nextUseSpectral = useSpectral.load();
+        if (currentUseSpectral != nextUseSpectral) {
+            currentUseSpectral = nextUseSpectral;
+            for (auto &s: spectralSideChains) {
+                s.reset();
+            }
+            for (auto &f: filters) {
+                f.getSideFilter().setToRest();
+                f.getCompressor().getTracker().reset();
+            }
+            sideShared.fill(false);
+        }
+        // the parallel form does not share states with the filters, reset them when switching
+        const auto nextUseParallel = useParallel.load();
+        if (currentUseParallel != nextUseParallel) {
+            currentUseParallel = nextUseParallel;
+            for (auto &f: filters) {
+                f.getMainFilter().setToRest();
+            }
+        }
+        // the baselines of all routes come from a single pass over the side chain
+        std::array<bool, 5> trackersON{};
+        for (size_t i = 0; i < trackersON.size(); ++i) {
+            trackersON[i] = useTrackers[i].load();
+        }
+        routeTracker.process(juce::dsp::AudioBlock<const FloatType>(subSideBuffer), trackersON);
+        std::array<FloatType, 5> baseLines{};
+        for (size_t i = 0; i < baseLines.size(); ++i) {
+            if (!trackersON[i]) { continue; }
+            baseLines[i] = routeTracker.getMomentaryLoudness(i);
+            if (baseLines[i] <= zlCompressor::RMSTracker<FloatType>::minusInfinityDB + 1) {
+                baseLines[i] = zlCompressor::RMSTracker<FloatType>::minusInfinityDB * FloatType(0.5);
             }
         }
+        // stereo filters process
+        const auto baseLine = baseLines[static_cast<size_t>(lrType::stereo)];
+        processSpectral(lrType::stereo, subSideBuffer);
+        processStatic(lrType::stereo, subMainBuffer);
         for (size_t i = 0; i < bandNUM; ++i) {
             if (dynRelatives[i].load()) {
                 filters[i].getCompressor().setBaseLine(baseLine);
             } else {
                 filters[i].getCompressor().setBaseLine(0);
             }
-            if (filterLRs[i].load() == lrType::stereo) {
-                filters[i].process(subMainBuffer, subSideBuffer);
+            if (currentStaticBands.lrs[i] == lrType::stereo && !isProcessedInCascade(i)) {
+                processBand(i, subMainBuffer, subSideBuffer);
             }
         }
         // LR filters process
-        if (useLR.load()) {
-            FloatType lBaseLine = 0, rBaseLine = 0;
+        if (currentStaticBands.useLR) {
+            const auto lBaseLine = baseLines[static_cast<size_t>(lrType::left)];
+            const auto rBaseLine = baseLines[static_cast<size_t>(lrType::right)];
             lrMainSplitter.split(subMainBuffer);
-            lrSideSplitter.split(subSideBuffer);
-            if (useTrackers[1].load()) {
-                lTracker.process(lrSideSplitter.getLBuffer());
-                lBaseLine = lTracker.getMomentaryLoudness();
-                if (lBaseLine <= lTracker.minusInfinityDB + 1) {
-                    lBaseLine = lTracker.minusInfinityDB * FloatType(0.5);
-                }
-            }
-            if (useTrackers[2].load()) {
-                rTracker.process(lrSideSplitter.getRBuffer());
-                rBaseLine = rTracker.getMomentaryLoudness();
-                if (rBaseLine <= rTracker.minusInfinityDB + 1) {
-                    rBaseLine = rTracker.minusInfinityDB * FloatType(0.5);
-                }
+            // the trackers do not need the split side chain, only the bands on the routes do
+            if (currentStaticBands.isSideUsed(lrType::left, lrType::right)) {
+                lrSideSplitter.split(subSideBuffer);
             }
+            processSpectral(lrType::left, lrSideSplitter.getLBuffer());
+            processSpectral(lrType::right, lrSideSplitter.getRBuffer());
+            processStatic(lrType::left, lrMainSplitter.getLBuffer());
+            processStatic(lrType::right, lrMainSplitter.getRBuffer());
             for (size_t i = 0; i < bandNUM; ++i) {
-                if (filterLRs[i].load() == lrType::left) {
+                if (isProcessedInCascade(i)) { continue; }
+                if (currentStaticBands.lrs[i] == lrType::left) {
                     if (dynRelatives[i].load()) {
                         filters[i].getCompressor().setBaseLine(lBaseLine);
                     } else {
                         filters[i].getCompressor().setBaseLine(0);
                     }
-                    filters[i].process(lrMainSplitter.getLBuffer(), lrSideSplitter.getLBuffer());
-                } else if (filterLRs[i].load() == lrType::right) {
+                    processBand(i, lrMainSplitter.getLBuffer(), lrSideSplitter.getLBuffer());
+                } else if (currentStaticBands.lrs[i] == lrType::right) {
                     if (dynRelatives[i].load()) {
                         filters[i].getCompressor().setBaseLine(rBaseLine);
                     } else {
                         filters[i].getCompressor().setBaseLine(0);
                     }
-                    filters[i].process(lrMainSplitter.getRBuffer(), lrSideSplitter.getRBuffer());
+                    processBand(i, lrMainSplitter.getRBuffer(), lrSideSplitter.getRBuffer());
                 }
             }
             lrMainSplitter.combine(subMainBuffer);
         }
         // MS filters process
-        if (useMS.load()) {
-            FloatType mBaseLine = 0, sBaseLine = 0;
+        if (currentStaticBands.useMS) {
+            const auto mBaseLine = baseLines[static_cast<size_t>(lrType::mid)];
+            const auto sBaseLine = baseLines[static_cast<size_t>(lrType::side)];
             msMainSplitter.split(subMainBuffer);
-            msSideSplitter.split(subSideBuffer);
-            if (useTrackers[3].load()) {
-                mTracker.process(msSideSplitter.getMBuffer());
-                mBaseLine = mTracker.getMomentaryLoudness();
-                if (mBaseLine <= mTracker.minusInfinityDB + 1) {
-                    mBaseLine = mTracker.minusInfinityDB * FloatType(0.5);
-                }
-            }
-            if (useTrackers[4].load()) {
-                sTracker.process(msSideSplitter.getSBuffer());
-                sBaseLine = sTracker.getMomentaryLoudness();
-                if (sBaseLine <= sTracker.minusInfinityDB + 1) {
-                    sBaseLine = sTracker.minusInfinityDB * FloatType(0.5);
-                }
+            if (currentStaticBands.isSideUsed(lrType::mid, lrType::side)) {
+                msSideSplitter.split(subSideBuffer);
             }
+            processSpectral(lrType::mid, msSideSplitter.getMBuffer());
+            processSpectral(lrType::side, msSideSplitter.getSBuffer());
+            processStatic(lrType::mid, msMainSplitter.getMBuffer());
+            processStatic(lrType::side, msMainSplitter.getSBuffer());
             for (size_t i = 0; i < bandNUM; ++i) {
-                if (filterLRs[i].load() == lrType::mid) {
+                if (isProcessedInCascade(i)) { continue; }
+                if (currentStaticBands.lrs[i] == lrType::mid) {
                     if (dynRelatives[i].load()) {
                         filters[i].getCompressor().setBaseLine(mBaseLine);
                     } else {
                         filters[i].getCompressor().setBaseLine(0);
                     }
-                    filters[i].process(msMainSplitter.getMBuffer(), msSideSplitter.getMBuffer());
-                } else if (filterLRs[i].load() == lrType::side) {
+                    processBand(i, msMainSplitter.getMBuffer(), msSideSplitter.getMBuffer());
+                } else if (currentStaticBands.lrs[i] == lrType::side) {
                     if (dynRelatives[i].load()) {
                         filters[i].getCompressor().setBaseLine(sBaseLine);
                     } else {
                         filters[i].getCompressor().setBaseLine(0);
                     }
-                    filters[i].process(msMainSplitter.getSBuffer(), msSideSplitter.getSBuffer());
+                    processBand(i, msMainSplitter.getSBuffer(), msSideSplitter.getSBuffer());
                 }
             }
             msMainSplitter.combine(subMainBuffer);
         }
         for (size_t i = 0; i < bandNUM; ++i) {
-            if (filters[i].getDynamicON() && isHistON[i].load()) {
+            if (!currentStaticBands.isStatic[i] && isHistON[i].load()) {
                 auto &compressor = filters[i].getCompressor();
-                const auto diff = compressor.getBaseLine() - compressor.getTracker().getMomentaryLoudness();
+                const auto diff = compressor.getBaseLine() - filters[i].getSideLoudness();
                 const auto histIdx = juce::jlimit(0, 80, juce::roundToInt(diff));
                 histograms[i].push(static_cast<size_t>(histIdx));
             }
@@ -287,40 +342,229 @@ namespace zlDSP {
     }
 
     template<typename FloatType>
-    void Controller<FloatType>::processBypass() {
+    void Controller<FloatType>::processBand(const size_t idx, juce::AudioBuffer<FloatType> &mBuffer,
+                                            juce::AudioBuffer<FloatType> &sBuffer) {
+        auto &f = filters[idx];
+        if (!currentStaticBands.isActive[idx]) { return; }
+        // the split side chain buffers are not filled for a static band
+        if (currentStaticBands.isStatic[idx]) {
+            f.processStatic(mBuffer);
+            return;
+        }
+        if (currentUseSpectral) {
+            const auto lr = static_cast<size_t>(currentStaticBands.lrs[idx]);
+            f.process(mBuffer, spectralSideChains[lr].getLoudness(idx));
+            return;
+        }
+        auto &source = sideSources[currentStaticBands.sideGroups[idx]];
+        if (source == bandNUM) {
+            // the side filter and the tracker have been idle while the band shared the side chain
+            if (sideShared[idx]) {
+                f.getSideFilter().setToRest();
+                f.getCompressor().getTracker().reset();
+                sideShared[idx] = false;
+            }
+            f.process(mBuffer, sBuffer);
+            source = idx;
+        } else {
+            f.process(mBuffer, filters[source]);
+            sideShared[idx] = true;
+        }
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::processSpectral(const lrType::lrTypes lr, juce::AudioBuffer<FloatType> &sBuffer) {
+        if (!currentUseSpectral) { return; }
+        auto &spectral = spectralSideChains[static_cast<size_t>(lr)];
+        bool isUsed = false;
         for (size_t i = 0; i < bandNUM; ++i) {
-            filters[i].processBypass();
+            const auto isON = currentStaticBands.lrs[i] == lr && !currentStaticBands.isStatic[i] &&
+                              currentStaticBands.isActive[i];
+            spectral.setBand(i, filters[i].getSideFilter(), isON);
+            isUsed = isUsed || isON;
+        }
+        if (isUsed) {
+            spectral.process(sBuffer, filters[0].getCompressor().getTracker().getMomentarySize());
         }
     }
 
     template<typename FloatType>
-    void Controller<FloatType>::setFilterLRs(const lrType::lrTypes x, const size_t idx) {
-        filterLRs[idx].store(x);
-        // update useLR and useMS
-        useLR.store(false);
-        for (auto &lr: filterLRs) {
-            if (lr.load() == lrType::left || lr.load() == lrType::right) {
-                useLR.store(true);
-                break;
+    void Controller<FloatType>::processStatic(const lrType::lrTypes lr, juce::AudioBuffer<FloatType> &buffer) {
+        const auto idx = static_cast<size_t>(lr);
+        const auto num = currentStaticBands.nums[idx];
+        // the block state-space form processes each band on its own
+        if (num == 0 || currentUseBlockSS || !zlDynamicFilter::StaticCascade<FloatType>::isAvailable(
+                static_cast<size_t>(buffer.getNumChannels()))) {
+            return;
+        }
+        if (currentUseParallel && zlDynamicFilter::ParallelCascade<FloatType>::isAvailable(
+                static_cast<size_t>(buffer.getNumChannels()))) {
+            fillCascade(parallelCascades[idx], idx);
+            parallelCascades[idx].process(buffer);
+        } else {
+            fillCascade(staticCascades[idx], idx);
+            staticCascades[idx].process(buffer);
+        }
+        cascadeON[idx] = true;
+    }
+
+    template<typename FloatType>
+    template<typename CascadeType>
+    void Controller<FloatType>::fillCascade(CascadeType &cascade, const size_t idx) {
+        cascade.clear();
+        for (size_t i = 0; i < currentStaticBands.nums[idx]; ++i) {
+            const auto bandIdx = currentStaticBands.indices[idx][i];
+            if (currentStaticBands.isActive[bandIdx]) {
+                cascade.add(filters[bandIdx], filters[bandIdx].getBypass());
             }
         }
-        useMS.store(false);
-        for (auto &lr: filterLRs) {
-            if (lr.load() == lrType::mid || lr.load() == lrType::side) {
-                useMS.store(true);
-                break;
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::resetStates() {
+        delay.reset();
+        subBuffer.reset();
+        routeTracker.reset();
+        for (auto &f: filters) {
+            f.getMainFilter().setToRest();
+            f.getSideFilter().setToRest();
+            f.getCompressor().reset();
+        }
+        sideShared.fill(false);
+        for (auto &s: spectralSideChains) {
+            s.reset();
+        }
+        for (auto &c: parallelCascades) {
+            c.reset();
+        }
+        autoGain.reset();
+        soloFilter.setToRest();
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::updateBlockSS(const int numSamples) {
+        const auto nextUseBlockSS = processorRef.isNonRealtime() || numSamples >= blockSSMinBlockSize;
+        if (currentUseBlockSS == nextUseBlockSS) { return; }
+        currentUseBlockSS = nextUseBlockSS;
+        for (auto &f: filters) {
+            f.setBlockSSON(currentUseBlockSS);
+            // the parallel form does not share states with the filters
+            if (currentUseParallel) {
+                f.getMainFilter().setToRest();
+            }
+        }
+        soloFilter.setBlockSSON(currentUseBlockSS);
+    }
+
+    template<typename FloatType>
+    int Controller<FloatType>::getNumSubBuffers() {
+        // dynamic bands keep the control rate of one sub buffer
+        if (!currentUseBlockSS || currentStaticBands.hasDynamic) { return 1; }
+        // so do the static bands while their parameters are changing (e.g. under automation), hence a change which
+        // arrives during a long block is applied at the next sub buffer, as it is in real-time processing
+        if (isParaOutdated()) {
+            paraHoldBlocks = paraHoldBlockNUM;
+        }
+        return paraHoldBlocks > 0 ? 1 : subBuffer.getMaxNumSubBuffers();
+    }
+
+    template<typename FloatType>
+    bool Controller<FloatType>::isParaOutdated() {
+        for (size_t i = 0; i < bandNUM; ++i) {
+            if (!currentStaticBands.isActive[i]) { continue; }
+            auto &f = filters[i];
+            if (f.getMainFilter().getParaOutdated() || f.getBaseFilter().getParaOutdated() ||
+                f.getTargetFilter().getParaOutdated()) {
+                return true;
+            }
+        }
+        return useSolo.load() && soloFilter.getParaOutdated();
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::updateTail() {
+        double tail = 0;
+        for (auto &f: filters) {
+            if (!f.getActive()) { continue; }
+            auto filterTail = f.getMainFilter().getTailSeconds();
+            // the main filter moves between the base and the target filter until the detector releases
+            if (f.getDynamicON()) {
+                filterTail = std::max({
+                    filterTail, f.getBaseFilter().getTailSeconds(), f.getTargetFilter().getTailSeconds()
+                });
+                filterTail += static_cast<double>(f.getCompressor().getDetector().getRelease()) / 1000.0 +
+                        static_cast<double>(f.getCompressor().getTracker().getMomentarySize()) / sampleRate.load();
+            }
+            tail = std::max(tail, filterTail);
+        }
+        if (useSolo.load()) {
+            tail = std::max(tail, soloFilter.getTailSeconds());
+        }
+        auto latency = static_cast<double>(delay.getDelaySamples());
+        if (!isZeroLatency.load()) {
+            latency += static_cast<double>(subBuffer.getLatencySamples());
+        }
+        tailSeconds.store(tail + latency / sampleRate.load());
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::prefetchCoeffs() {
+        size_t num = 0;
+        for (auto &f: filters) {
+            if (!f.getActive()) { continue; }
+            for (auto *filter: {&f.getMainFilter(), &f.getBaseFilter(), &f.getTargetFilter()}) {
+                if (filter->getPendingSpec(pendingSpecs[num])) { num += 1; }
             }
         }
+        // a single update gains nothing from the batch
+        if (num > 1) {
+            coeffCache.prefetch(pendingSpecs.data(), num);
+        }
+    }
+
+    template<typename FloatType>
+    size_t Controller<FloatType>::getIdleBlocks() const {
+        size_t num = soloFilter.getIdleBlocks();
+        for (const auto &f: filters) {
+            num += f.getMainFilter().getIdleBlocks();
+        }
+        return num;
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::processBypass() {
+        for (size_t i = 0; i < bandNUM; ++i) {
+            filters[i].processBypass();
+        }
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::setFilterLRs(const lrType::lrTypes x, const size_t idx) {
+        filterLRs[idx].store(x);
         updateTrackersON();
+        toUpdateStaticBands.store(true);
     }
 
     template<typename FloatType>
     void Controller<FloatType>::setDynamicON(const bool x, size_t idx) {
         filters[idx].setDynamicON(x);
+        toUpdateStaticBands.store(true);
         filters[idx].getMainFilter().setGain(filters[idx].getBaseFilter().getGain(), false);
         filters[idx].getMainFilter().setQ(filters[idx].getBaseFilter().getQ(), true);
     }
 
+    template<typename FloatType>
+    void Controller<FloatType>::setSideFreq(const FloatType x, const size_t idx) {
+        filters[idx].getSideFilter().setFreq(x);
+        toUpdateStaticBands.store(true);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::setSideQ(const FloatType x, const size_t idx) {
+        filters[idx].getSideFilter().setQ(x);
+        toUpdateStaticBands.store(true);
+    }
+
     template<typename FloatType>
     void Controller<FloatType>::updateDBs(const lrType::lrTypes lr) {
         dBs.fill(FloatType(0));
@@ -334,8 +578,35 @@ namespace zlDSP {
         }
     }
 
+    template<typename FloatType>
+    void Controller<FloatType>::updateResponses(const lrType::lrTypes lr,
+                                                zlIIR::ResponseEngine::ComplexResponse &response) {
+        response.reset();
+        for (size_t i = 0; i < bandNUM; i++) {
+            if (filterLRs[i].load() == lr && !filters[i].getBypass()) {
+                filters[i].getMainFilter().multiplyResponses(response);
+            }
+        }
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::setSpectralON(const bool x) {
+        useSpectral.store(x);
+        updateSpectralDelay();
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::updateSpectralDelay() {
+        delay.setExtraDelaySamples(useSpectral.load()
+                                       ? zlDynamicFilter::SpectralSideChain<FloatType>::getLatencySamples(
+                                           sampleRate.load())
+                                       : 0);
+        triggerAsyncUpdate();
+    }
+
     template<typename FloatType>
     void Controller<FloatType>::handleAsyncUpdate() {
+        // the delay includes the lookahead and the latency of the spectral side chain
         int latency = static_cast<int>(delay.getDelaySamples());
         if (!isZeroLatency.load()) {
             latency += static_cast<int>(subBuffer.getLatencySamples());
@@ -416,6 +687,39 @@ namespace zlDSP {
         }
     }
 
+    template<typename FloatType>
+    void Controller<FloatType>::updateStaticBands() {
+        auto &bands = currentStaticBands;
+        bands.nums.fill(0);
+        bands.hasDynamic = false;
+        bands.useLR = false;
+        bands.useMS = false;
+        for (size_t i = 0; i < bandNUM; ++i) {
+            const auto lr = filterLRs[i].load();
+            bands.lrs[i] = lr;
+            bands.useLR = bands.useLR || lr == lrType::left || lr == lrType::right;
+            bands.useMS = bands.useMS || lr == lrType::mid || lr == lrType::side;
+            bands.isStatic[i] = !filters[i].getDynamicON();
+            bands.hasDynamic = bands.hasDynamic || !bands.isStatic[i];
+            if (bands.isStatic[i]) {
+                const auto idx = static_cast<size_t>(lr);
+                bands.indices[idx][bands.nums[idx]] = i;
+                bands.nums[idx] += 1;
+            }
+            bands.sideGroups[i] = i;
+            if (bands.isStatic[i]) { continue; }
+            auto &sFilter = filters[i].getSideFilter();
+            for (size_t j = 0; j < i; ++j) {
+                auto &other = filters[j].getSideFilter();
+                if (!bands.isStatic[j] && bands.lrs[j] == lr &&
+                    other.getFreq() == sFilter.getFreq() && other.getQ() == sFilter.getQ()) {
+                    bands.sideGroups[i] = bands.sideGroups[j];
+                    break;
+                }
+            }
+        }
+    }
+
     template<typename FloatType>
     void Controller<FloatType>::setLearningHist(const size_t idx, const bool isLearning) {
         if (isLearning) {
@@ -23,6 +23,36 @@
 #include "delay/delay.hpp"
 
 namespace zlDSP {
+    /**
+     * the band layout of a block: the route of each band and the static (non-dynamic) bands of each route
+     * dynamic bands on the same route whose side filters are identical form a side group,
+     * the side chain of a group is filtered and tracked once per block
+     * all routing decisions of a block are taken from it, so that a parameter change never splits a block
+     */
+    struct StaticBands {
+        std::array<std::array<size_t, bandNUM>, 5> indices{};
+        std::array<size_t, 5> nums{};
+        std::array<lrType::lrTypes, bandNUM> lrs{};
+        std::array<bool, bandNUM> isStatic{};
+        /** the smallest band index of the side group of each band */
+        std::array<size_t, bandNUM> sideGroups{};
+        bool hasDynamic{false};
+        /** whether any band is on the L/R routes, or on the M/S routes */
+        bool useLR{false}, useMS{false};
+        /** whether each band is active, it is updated every block */
+        std::array<bool, bandNUM> isActive{};
+
+        /**
+         * @return whether an active band on the two routes reads the split side chain, only dynamic bands do
+         */
+        bool isSideUsed(const lrType::lrTypes lr1, const lrType::lrTypes lr2) const {
+            for (size_t i = 0; i < bandNUM; ++i) {
+                if (isActive[i] && !isStatic[i] && (lrs[i] == lr1 || lrs[i] == lr2)) { return true; }
+            }
+            return false;
+        }
+    };
+
     template<typename FloatType>
     class Controller : public juce::AsyncUpdater {
     public:
@@ -36,6 +66,13 @@ namespace zlDSP {
 
         void processBypass();
 
+        /**
+         * reset the states of the whole chain at the next block, e.g. when the controller resumes processing
+         * after another controller has processed the audio: the lookahead delay, the sub buffers,
+         * the loudness trackers, the compressors, the spectral side chains, the auto gain and all filters
+         */
+        void setToRest() { toReset.store(true); }
+
         inline zlDynamicFilter::IIRFilter<FloatType> &getFilter(const size_t idx) { return filters[idx]; }
 
         inline std::array<zlDynamicFilter::IIRFilter<FloatType>, bandNUM> &getFilters() { return filters; }
@@ -46,10 +83,21 @@ namespace zlDSP {
 
         void setDynamicON(bool x, size_t idx);
 
+        void setSideFreq(FloatType x, size_t idx);
+
+        void setSideQ(FloatType x, size_t idx);
+
         inline std::array<double, zlIIR::frequencies.size()> &getDBs() { return dBs; }
 
         void updateDBs(lrType::lrTypes lr);
 
+        /**
+         * evaluate the complex response (magnitude, phase and group delay) of the filters on a L/R/M/S route
+         * @param lr the route
+         * @param response
+         */
+        void updateResponses(lrType::lrTypes lr, zlIIR::ResponseEngine::ComplexResponse &response);
+
         void handleAsyncUpdate() override;
 
         void setSolo(size_t idx, bool isSide);
@@ -96,22 +144,49 @@ namespace zlDSP {
 
         bool getDynLink() const { return dynLink.load(); }
 
+        void setParallelON(const bool x) {
+            useParallel.store(x);
+            parallelDesigner.setON(x);
+        }
+
         void setZeroLatency(const bool x) {
             isZeroLatency.store(x);
             triggerAsyncUpdate();
         }
 
+        /**
+         * set whether the side chain loudness of dynamic bands is analyzed from one STFT per route
+         * (see SpectralSideChain), the main chain is delayed by the latency of the analysis
+         * @param x
+         */
+        void setSpectralON(bool x);
+
+        /**
+         * get the total number of blocks skipped by idle bands
+         * @return
+         */
+        size_t getIdleBlocks() const;
+
+        /**
+         * get the time for the output to decay to silence after the input stops, including the latency
+         * it is updated once per block
+         * @return
+         */
+        double getTailSeconds() const { return tailSeconds.load(); }
+
+        const zlIIR::CoeffCache &getCoeffCache() const { return coeffCache; }
+
     private:
         juce::AudioProcessor &processorRef;
+        zlIIR::CoeffCache coeffCache;
         std::array<zlDynamicFilter::IIRFilter<FloatType>, bandNUM> filters;
 
         std::array<std::atomic<lrType::lrTypes>, bandNUM> filterLRs;
         zlSplitter::LRSplitter<FloatType> lrMainSplitter, lrSideSplitter;
         zlSplitter::MSSplitter<FloatType> msMainSplitter, msSideSplitter;
-        std::atomic<bool> useLR, useMS;
 
         std::array<std::atomic<bool>, bandNUM> dynRelatives;
-        zlCompressor::RMSTracker<FloatType> tracker, lTracker, rTracker, mTracker, sTracker;
+        zlCompressor::RouteTracker<FloatType> routeTracker;
         std::array<std::atomic<bool>, 5> useTrackers;
 
         std::atomic<bool> sideChain;
@@ -146,6 +221,51 @@ namespace zlDSP {
 
         std::atomic<bool> isZeroLatency{false};
 
+        /** set by the parameter setters, the layout is rebuilt on the audio thread at the start of the next block */
+        std::atomic<bool> toUpdateStaticBands{true};
+        StaticBands currentStaticBands;
+        std::array<zlDynamicFilter::StaticCascade<FloatType>, 5> staticCascades;
+        std::array<bool, 5> cascadeON{};
+
+        std::array<zlDynamicFilter::ParallelCascade<FloatType>, 5> parallelCascades;
+        zlDynamicFilter::ParallelDesigner<FloatType> parallelDesigner;
+        std::atomic<bool> useParallel{false};
+        bool currentUseParallel{false};
+
+        /**
+         * the block state-space form is used for offline rendering and long host blocks
+         * if no band is dynamic, up to blockSSSubBufferNUM sub buffers are processed at once
+         * while the parameters are changing, the sub buffers are processed one by one for paraHoldBlockNUM blocks
+         */
+        static constexpr int blockSSSubBufferNUM = 64;
+        static constexpr int blockSSMinBlockSize = 1024;
+        static constexpr int paraHoldBlockNUM = 2;
+        bool currentUseBlockSS{false};
+        int paraHoldBlocks{0};
+
+        void updateBlockSS(int numSamples);
+
+        /**
+         * @return the number of sub buffers to process at once, call it before each pop of the sub buffers
+         */
+        int getNumSubBuffers();
+
+        /**
+         * @return whether the parameters of any active band have changed since its coefficients were updated
+         */
+        bool isParaOutdated();
+
+        std::atomic<double> tailSeconds{0};
+
+        void updateTail();
+
+        std::array<zlIIR::DesignSpec, bandNUM * 3> pendingSpecs{};
+
+        /**
+         * design the pending coefficients of all bands in one batch before the bands are processed
+         */
+        void prefetchCoeffs();
+
         void processSubBuffer(juce::AudioBuffer<FloatType> &subMainBuffer,
                               juce::AudioBuffer<FloatType> &subSideBuffer);
 
@@ -155,8 +275,59 @@ namespace zlDSP {
         void processDynamic(juce::AudioBuffer<FloatType> &subMainBuffer,
                             juce::AudioBuffer<FloatType> &subSideBuffer);
 
+        /**
+         * process all active static bands of a channel route in one fused cascade
+         * @param lr channel route
+         * @param buffer main chain audio buffer of the route
+         */
+        void processStatic(lrType::lrTypes lr, juce::AudioBuffer<FloatType> &buffer);
+
+        template<typename CascadeType>
+        void fillCascade(CascadeType &cascade, size_t idx);
+
+        static_assert(bandNUM <= zlDynamicFilter::SpectralSideChain<FloatType>::maxBands);
+        std::array<zlDynamicFilter::SpectralSideChain<FloatType>, 5> spectralSideChains;
+        std::atomic<bool> useSpectral{false};
+        bool currentUseSpectral{false};
+
+        /**
+         * analyze the side chain of a route if the spectral side chain is on
+         * @param lr channel route
+         * @param sBuffer side chain audio buffer of the route
+         */
+        void processSpectral(lrType::lrTypes lr, juce::AudioBuffer<FloatType> &sBuffer);
+
+        void updateSpectralDelay();
+
+        /** the band which has filtered the side chain of each side group in this block, bandNUM if none */
+        std::array<size_t, bandNUM> sideSources{};
+        /** whether each band took its side chain loudness from another band in the last block */
+        std::array<bool, bandNUM> sideShared{};
+
+        std::atomic<bool> toReset{false};
+
+        void resetStates();
+
+        /**
+         * process a band which is not in a fused cascade, the side chain is shared within its side group
+         * @param idx band index
+         * @param mBuffer main chain audio buffer of the route
+         * @param sBuffer side chain audio buffer of the route
+         */
+        void processBand(size_t idx, juce::AudioBuffer<FloatType> &mBuffer, juce::AudioBuffer<FloatType> &sBuffer);
+
+        inline bool isProcessedInCascade(const size_t idx) const {
+            return currentStaticBands.isStatic[idx] && cascadeON[static_cast<size_t>(currentStaticBands.lrs[idx])];
+        }
+
         void updateTrackersON();
 
+        /**
+         * rebuild the band layout from the parameters, it only reads atomics and never waits
+         * DO NOT call it outside the real-time thread (or before the processing starts)
+         */
+        void updateStaticBands();
+
         void updateSubBuffer();
     };
 }
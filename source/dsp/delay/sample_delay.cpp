@@ -24,7 +24,7 @@ namespace zlDelay {
 
     template<typename FloatType>
     void SampleDelay<FloatType>::process(juce::dsp::AudioBlock<FloatType> block) {
-        const auto delaySamples = static_cast<int>(static_cast<double>(delaySeconds.load()) * sampleRate.load());
+        const auto delaySamples = getDelaySamples();
         if (delaySamples == 0) { return; }
         if (static_cast<int>(delayDSP.getDelay()) != delaySamples) {
             delayDSP.setDelay(static_cast<FloatType>(delaySamples));
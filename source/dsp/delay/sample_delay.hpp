@@ -26,6 +26,13 @@ namespace zlDelay {
 
         void prepare(const juce::dsp::ProcessSpec &spec);
 
+        /**
+         * clear the delayed samples
+         */
+        void reset() {
+            delayDSP.reset();
+        }
+
         void setMaximumDelayInSamples(const int maxDelayInSamples) {
             delayDSP.setMaximumDelayInSamples(maxDelayInSamples);
         }
@@ -38,13 +45,23 @@ namespace zlDelay {
             delaySeconds.store(x);
         }
 
+        /**
+         * set the delay (in samples) which is added to the delay in seconds, e.g. the latency of an analysis
+         * @param x
+         */
+        void setExtraDelaySamples(const int x) {
+            extraSamples.store(x);
+        }
+
         int getDelaySamples() const {
-            return static_cast<int>(static_cast<double>(delaySeconds.load()) * sampleRate.load());
+            return static_cast<int>(static_cast<double>(delaySeconds.load()) * sampleRate.load()) +
+                   extraSamples.load();
         }
 
     private:
         std::atomic<double> sampleRate{44100};
         std::atomic<FloatType> delaySeconds{0};
+        std::atomic<int> extraSamples{0};
         juce::dsp::DelayLine<FloatType> delayDSP;
     };
 } // zlDelay
@@ -391,7 +391,7 @@ namespace zlDSP {
         auto static constexpr ID = "filter_structure";
         auto static constexpr name = "Filter Structure";
         inline auto static const choices = juce::StringArray{
-            "Transposed DF-II", "State Variable"
+            "Transposed DF-II", "State Variable", "Parallel"
         };
         int static constexpr defaultI = 0;
     };
@@ -416,6 +416,16 @@ namespace zlDSP {
         int static constexpr defaultI = 0;
     };
 
+    class dynSpectral : public ChoiceParameters<dynSpectral> {
+    public:
+        auto static constexpr ID = "dyn_spectral";
+        auto static constexpr name = "Dynamic Spectral";
+        inline auto static const choices = juce::StringArray{
+            "OFF", "ON"
+        };
+        int static constexpr defaultI = 0;
+    };
+
     class zeroLatency : public ChoiceParameters<zeroLatency> {
     public:
         auto static constexpr ID = "zero_latency";
@@ -426,6 +436,16 @@ namespace zlDSP {
         int static constexpr defaultI = 0;
     };
 
+    class precision : public ChoiceParameters<precision> {
+    public:
+        auto static constexpr ID = "precision";
+        auto static constexpr name = "Precision";
+        inline auto static const choices = juce::StringArray{
+            "Double", "Float"
+        };
+        int static constexpr defaultI = 0;
+    };
+
     inline juce::AudioProcessorValueTreeState::ParameterLayout getParameterLayout() {
         juce::AudioProcessorValueTreeState::ParameterLayout layout;
         for (int i = 0; i < bandNUM; ++i) {
@@ -436,7 +456,8 @@ namespace zlDSP {
                    dynLookahead::get(), dynRMS::get(), dynSmooth::get(),
                    effectON::get(), staticAutoGain::get(), autoGain::get(),
                    scale::get(), outputGain::get(),
-                   filterStructure::get(), dynLink::get(), dynHQ::get(), zeroLatency::get());
+                   filterStructure::get(), dynLink::get(), dynHQ::get(), dynSpectral::get(), zeroLatency::get(),
+                   precision::get());
         return layout;
     }
 
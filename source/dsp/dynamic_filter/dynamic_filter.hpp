@@ -11,5 +11,8 @@
 #define ZLEQUALIZER_DYNAMIC_FILTER_HPP
 
 #include "dynamic_iir_filter.hpp"
+#include "static_cascade.hpp"
+#include "parallel_cascade.hpp"
+#include "spectral_side_chain.hpp"
 
 #endif //ZLEQUALIZER_DYNAMIC_FILTER_HPP
@@ -30,49 +30,46 @@ namespace zlDynamicFilter {
         compensation.prepare(spec);
 
         compressor.getComputer().setRatio(100);
-        sBufferCopy.setSize(static_cast<int>(spec.numChannels),
-                            static_cast<int>(spec.maximumBlockSize));
+        sideBlock = juce::dsp::AudioBlock<FloatType>(sideData, spec.numChannels, spec.maximumBlockSize);
     }
 
     template<typename FloatType>
     void IIRFilter<FloatType>::process(juce::AudioBuffer<FloatType> &mBuffer, juce::AudioBuffer<FloatType> &sBuffer) {
         if (!active.load()) { return; }
-        if (bFilter.updateParasForDBOnly()) {
-            compensation.update();
-        }
-        tFilter.updateParasForDBOnly();
-        sFilter.updateParas();
+        updateSubParas();
         const auto currentBypass = bypass.load();
         if (dynamicON.load()) {
-            sBufferCopy.makeCopyOf(sBuffer, true);
-            sFilter.process(sBufferCopy);
-            auto reducedLoudness = juce::Decibels::gainToDecibels(compressor.process(sBufferCopy));
-            auto maximumReduction = compressor.getComputer().getReductionAtKnee();
-            auto portion = std::min(reducedLoudness / maximumReduction, FloatType(1));
-            if (dynamicBypass.load()) {
-                portion = 0;
-            }
-            if (!isPerSample.load()) {
-                mFilter.setGain((1 - portion) * bFilter.getGain() + portion * tFilter.getGain(), false);
-                mFilter.setQ((1 - portion) * bFilter.getQ() + portion * tFilter.getQ(), true);
+            // the side filter writes into the scratch region, and the compressor reads it in place
+            const auto sideInput = juce::dsp::AudioBlock<const FloatType>(sBuffer);
+            const auto sideOutput = sideBlock.getSubsetChannelBlock(0, sideInput.getNumChannels())
+                    .getSubBlock(0, sideInput.getNumSamples());
+            jassert(sideInput.getNumSamples() <= sideBlock.getNumSamples());
+            sFilter.processTo(sideInput, sideOutput);
+            const auto reducedGain = compressor.process(sideOutput);
+            sideLoudness = compressor.getTracker().getMomentaryLoudness();
+            processDynamic(mBuffer, reducedGain, currentBypass);
+        } else {
+            mFilter.process(mBuffer, currentBypass);
+        }
+        if (!currentBypass) {
+            compensation.process(mBuffer);
+        }
+    }
 
-                mFilter.process(mBuffer, currentBypass);
-            } else {
-                const auto oldGain = mFilter.getGain();
-                const auto oldQ = mFilter.getQ();
-                const auto newGain = (1 - portion) * bFilter.getGain() + portion * tFilter.getGain();
-                const auto newQ = (1 - portion) * bFilter.getQ() + portion * tFilter.getQ();
-                auto audioWriters = mBuffer.getArrayOfWritePointers();
-                for (int i = 0; i < mBuffer.getNumSamples(); ++i) {
-                    const auto pp = static_cast<FloatType>(i) / static_cast<FloatType>(mBuffer.getNumSamples());
-                    const auto currentGain = newGain * pp + oldGain * (1 - pp);
-                    const auto currentQ = newQ * pp + oldQ * (1 - pp);
-                    mFilter.setGain(currentGain, false);
-                    mFilter.setQ(currentQ, true);
-                    sampleBuffer.setDataToReferTo(audioWriters, static_cast<int>(mBuffer.getNumChannels()), i, 1);
-                    mFilter.process(sampleBuffer, currentBypass);
-                }
-            }
+    template<typename FloatType>
+    void IIRFilter<FloatType>::process(juce::AudioBuffer<FloatType> &mBuffer, const IIRFilter &sideSource) {
+        process(mBuffer, sideSource.getSideLoudness());
+    }
+
+    template<typename FloatType>
+    void IIRFilter<FloatType>::process(juce::AudioBuffer<FloatType> &mBuffer, const FloatType loudness) {
+        if (!active.load()) { return; }
+        updateSubParas();
+        const auto currentBypass = bypass.load();
+        if (dynamicON.load()) {
+            sideLoudness = loudness;
+            const auto reducedGain = compressor.process(sideLoudness, mBuffer.getNumSamples());
+            processDynamic(mBuffer, reducedGain, currentBypass);
         } else {
             mFilter.process(mBuffer, currentBypass);
         }
@@ -81,6 +78,58 @@ namespace zlDynamicFilter {
         }
     }
 
+    template<typename FloatType>
+    void IIRFilter<FloatType>::processDynamic(juce::AudioBuffer<FloatType> &mBuffer,
+                                              const FloatType reducedGain, const bool currentBypass) {
+        auto reducedLoudness = juce::Decibels::gainToDecibels(reducedGain);
+        auto maximumReduction = compressor.getComputer().getReductionAtKnee();
+        auto portion = std::min(reducedLoudness / maximumReduction, FloatType(1));
+        if (dynamicBypass.load()) {
+            portion = 0;
+        }
+        mFilter.setGain((1 - portion) * bFilter.getGain() + portion * tFilter.getGain(), false);
+        mFilter.setQ((1 - portion) * bFilter.getQ() + portion * tFilter.getQ(), true);
+        if (!isPerSample.load()) {
+            mFilter.process(mBuffer, currentBypass);
+        } else {
+            // only the coefficients at the block end are designed, and they are interpolated per sample
+            mFilter.processRamp(mBuffer, currentBypass);
+        }
+    }
+
+    template<typename FloatType>
+    void IIRFilter<FloatType>::processStatic(juce::AudioBuffer<FloatType> &mBuffer) {
+        if (!active.load()) { return; }
+        updateSubParas();
+        const auto currentBypass = bypass.load();
+        mFilter.process(mBuffer, currentBypass);
+        if (!currentBypass) {
+            compensation.process(mBuffer);
+        }
+    }
+
+    template<typename FloatType>
+    bool IIRFilter<FloatType>::prepareStatic(const bool isBypassed) {
+        updateSubParas();
+        return mFilter.prepareBlock(isBypassed);
+    }
+
+    template<typename FloatType>
+    void IIRFilter<FloatType>::finishStatic(juce::AudioBuffer<FloatType> &mBuffer, const bool isBypassed) {
+        if (!isBypassed) {
+            compensation.process(mBuffer);
+        }
+    }
+
+    template<typename FloatType>
+    void IIRFilter<FloatType>::updateSubParas() {
+        if (bFilter.updateParasForDBOnly()) {
+            compensation.update();
+        }
+        tFilter.updateParasForDBOnly();
+        sFilter.updateParas();
+    }
+
     template<typename FloatType>
     void IIRFilter<FloatType>::processBypass() {
         if (bFilter.updateParas()) {
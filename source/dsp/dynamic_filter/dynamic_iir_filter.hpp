@@ -39,10 +39,47 @@ namespace zlDynamicFilter {
          */
         void process(juce::AudioBuffer<FloatType> &mBuffer, juce::AudioBuffer<FloatType> &sBuffer);
 
+        /**
+         * process the audio buffer with the side chain loudness of another band whose side filter is identical
+         * the source band must have processed the same side chain buffer in this block
+         * @param mBuffer main chain audio buffer
+         * @param sideSource the band which has filtered the side chain
+         */
+        void process(juce::AudioBuffer<FloatType> &mBuffer, const IIRFilter &sideSource);
+
+        /**
+         * process the audio buffer with a side chain loudness which has been analyzed elsewhere
+         * @param mBuffer main chain audio buffer
+         * @param loudness momentary loudness (in dB) of the side chain
+         */
+        void process(juce::AudioBuffer<FloatType> &mBuffer, FloatType loudness);
+
+        /**
+         * process the audio buffer as a static (non-dynamic) filter, the side chain is not read
+         * @param mBuffer main chain audio buffer
+         */
+        void processStatic(juce::AudioBuffer<FloatType> &mBuffer);
+
         void processBypass();
 
+        /**
+         * update the parameters of a static (non-dynamic) filter whose main filter sections are processed outside
+         * @param isBypassed whether the filter is bypassed
+         * @return whether the main filter sections should be bypassed in this block
+         */
+        bool prepareStatic(bool isBypassed);
+
+        /**
+         * finish a static filter block after its main filter sections have been processed outside
+         * @param mBuffer main chain audio buffer
+         * @param isBypassed whether the filter is bypassed
+         */
+        void finishStatic(juce::AudioBuffer<FloatType> &mBuffer, bool isBypassed);
+
         inline zlIIR::Filter<FloatType> &getMainFilter() { return mFilter; }
 
+        inline const zlIIR::Filter<FloatType> &getMainFilter() const { return mFilter; }
+
         inline zlIIR::Filter<FloatType> &getBaseFilter() { return bFilter; }
 
         inline zlIIR::Filter<FloatType> &getTargetFilter() { return tFilter; }
@@ -51,10 +88,17 @@ namespace zlDynamicFilter {
 
         inline zlCompressor::ForwardCompressor<FloatType> &getCompressor() { return compressor; }
 
+        /**
+         * @return the momentary loudness (in dB) of the filtered side chain in the last block
+         */
+        inline FloatType getSideLoudness() const { return sideLoudness; }
+
         inline void setBypass(const bool x) { bypass.store(x); }
 
         inline bool getBypass() const { return bypass.load(); }
 
+        inline bool getActive() const { return active.load(); }
+
         inline void setActive(const bool x) {
             if (x) {
                 mFilter.setToRest();
@@ -62,7 +106,14 @@ namespace zlDynamicFilter {
             active.store(x);
         }
 
-        inline void setDynamicON(const bool x) { dynamicON.store(x); }
+        /**
+         * set whether the filter is dynamic, the main filter of a dynamic filter is designed with FastMath
+         * @param x
+         */
+        inline void setDynamicON(const bool x) {
+            mFilter.setFastMathON(x);
+            dynamicON.store(x);
+        }
 
         inline bool getDynamicON() const { return dynamicON.load(); }
 
@@ -77,16 +128,37 @@ namespace zlDynamicFilter {
             sFilter.setSVFON(f);
         }
 
+        void setBlockSSON(const bool f) {
+            mFilter.setBlockSSON(f);
+            sFilter.setBlockSSON(f);
+        }
+
+        /**
+         * set whether the curves of the main, base and target filters are drawn from the analog prototypes
+         * @param f
+         */
+        void setAnalogCurveON(const bool f) {
+            mFilter.setAnalogCurveON(f);
+            bFilter.setAnalogCurveON(f);
+            tFilter.setAnalogCurveON(f);
+        }
+
         void setIsPerSample(const bool x) {isPerSample.store(x);}
 
     private:
         zlIIR::Filter<FloatType> mFilter, bFilter, tFilter, sFilter;
         zlIIR::StaticGainCompensation<FloatType> compensation {bFilter};
         zlCompressor::ForwardCompressor<FloatType> compressor;
-        juce::AudioBuffer<FloatType> sBufferCopy;
+        /** the scratch region which the side filter writes into, allocated in prepare */
+        juce::HeapBlock<char> sideData;
+        juce::dsp::AudioBlock<FloatType> sideBlock;
+        FloatType sideLoudness{0};
         std::atomic<bool> bypass{true}, active{false}, dynamicON{false}, dynamicBypass{false};
-        juce::AudioBuffer<FloatType> sampleBuffer;
         std::atomic<bool> isPerSample{false};
+
+        void updateSubParas();
+
+        void processDynamic(juce::AudioBuffer<FloatType> &mBuffer, FloatType reducedGain, bool currentBypass);
     };
 }
 
@@ -0,0 +1,246 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include "parallel_cascade.hpp"
+
+namespace zlDynamicFilter {
+    template<typename FloatType>
+    void ParallelCascade<FloatType>::prepare(const juce::dsp::ProcessSpec &spec) {
+        fadeBuffer.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+        maxWarmLength = static_cast<size_t>(spec.sampleRate * maxWarmSeconds);
+        rampLength = std::max(static_cast<size_t>(spec.sampleRate * rampSeconds), size_t(2));
+        fadeLength = rampLength;
+        fadePos = 0;
+        isFading = false;
+    }
+
+    template<typename FloatType>
+    void ParallelCascade<FloatType>::clear() {
+        cascade.clear();
+        numSections = 0;
+    }
+
+    template<typename FloatType>
+    void ParallelCascade<FloatType>::add(IIRFilter<FloatType> &filter, const bool isBypassed) {
+        cascade.add(filter, isBypassed);
+        if (isBypassed) { return; }
+        auto &mFilter = filter.getMainFilter();
+        const auto &coeffs = mFilter.getCoeffs();
+        for (size_t i = 0; i < mFilter.getFilterNum() && numSections < maxSections; ++i) {
+            sections[numSections] = coeffs[i];
+            numSections += 1;
+        }
+    }
+
+    template<typename FloatType>
+    void ParallelCascade<FloatType>::reset() {
+        form.reset();
+        if (isFading) {
+            isParallel = !isParallel;
+            isFading = false;
+        }
+        fadePos = 0;
+    }
+
+    template<typename FloatType>
+    void ParallelCascade<FloatType>::process(juce::AudioBuffer<FloatType> &buffer) {
+        // request a new decomposition if the cascade has changed
+        if (numSections != numRequested ||
+            !std::equal(sections.begin(), sections.begin() + static_cast<std::ptrdiff_t>(numSections),
+                        requestedSections.begin())) {
+            std::copy(sections.begin(), sections.begin() + static_cast<std::ptrdiff_t>(numSections),
+                      requestedSections.begin());
+            numRequested = numSections;
+            requestVersion += 1;
+            {
+                farbot::RealtimeObject<
+                    ParallelRequest,
+                    farbot::RealtimeObjectOptions::realtimeMutatable>::ScopedAccess<
+                    farbot::ThreadType::realtime> rRequest(request);
+                std::copy(sections.begin(), sections.begin() + static_cast<std::ptrdiff_t>(numSections),
+                          rRequest->sections.begin());
+                rRequest->num = numSections;
+                rRequest->version = requestVersion;
+            }
+            toDesign.store(true);
+            if (designer != nullptr) {
+                designer->wake();
+            }
+        }
+        // load the most recent decomposition
+        if (resultVersion.load() != appliedVersion) {
+            farbot::RealtimeObject<
+                zlIIR::ParallelCoeffs,
+                farbot::RealtimeObjectOptions::nonRealtimeMutatable>::ScopedAccess<
+                farbot::ThreadType::realtime> rResult(result);
+            // keep the last valid decomposition, the parallel form may still be fading out with it
+            if (rResult->valid) {
+                form.setCoeffs(*rResult);
+            }
+            appliedVersion = rResult->version;
+            isValid = rResult->valid;
+        }
+        if (!isFading && isValid != isParallel) {
+            if (isValid) {
+                form.reset();
+            } else {
+                cascade.resetSections();
+            }
+            warmLength = std::min(getDecayLength(), maxWarmLength);
+            fadeLength = warmLength + rampLength;
+            isFading = true;
+            fadePos = 0;
+        }
+        if (!isFading) {
+            processForm(isParallel, buffer);
+            cascade.finish(buffer);
+            return;
+        }
+        // the incoming form processes a copy of the input
+        const auto numChannels = buffer.getNumChannels(), numSamples = buffer.getNumSamples();
+        fadeBuffer.setSize(numChannels, numSamples, false, false, true);
+        for (int channel = 0; channel < numChannels; ++channel) {
+            fadeBuffer.copyFrom(channel, 0, buffer, channel, 0, numSamples);
+        }
+        processForm(isParallel, buffer);
+        processForm(!isParallel, fadeBuffer);
+        // it is silent while its states warm up
+        const auto ramp = static_cast<FloatType>(rampLength);
+        for (int channel = 0; channel < numChannels; ++channel) {
+            auto *out = buffer.getWritePointer(channel);
+            const auto *in = fadeBuffer.getReadPointer(channel);
+            for (size_t i = 0; i < static_cast<size_t>(numSamples); ++i) {
+                const auto pos = fadePos + i;
+                if (pos <= warmLength) { continue; }
+                const auto g = std::min(static_cast<FloatType>(pos - warmLength) / ramp, FloatType(1));
+                out[i] += g * (in[i] - out[i]);
+            }
+        }
+        fadePos += static_cast<size_t>(numSamples);
+        if (fadePos >= fadeLength) {
+            isParallel = !isParallel;
+            isFading = false;
+        }
+        cascade.finish(buffer);
+    }
+
+    template<typename FloatType>
+    void ParallelCascade<FloatType>::processForm(const bool parallel, juce::AudioBuffer<FloatType> &buffer) {
+        if (parallel) {
+            form.process(juce::dsp::AudioBlock<FloatType>(buffer));
+        } else {
+            cascade.processSections(buffer);
+        }
+    }
+
+    template<typename FloatType>
+    size_t ParallelCascade<FloatType>::getDecayLength() const {
+        // the largest pole radius of the sections, a = {1, a1, a2}
+        double radius = 0;
+        for (size_t i = 0; i < numSections; ++i) {
+            const auto &a = std::get<0>(sections[i]);
+            const auto disc = a[1] * a[1] - 4 * a[2];
+            const auto r = disc < 0 ? std::sqrt(a[2]) : 0.5 * (std::abs(a[1]) + std::sqrt(disc));
+            radius = std::max(radius, r);
+        }
+        if (radius <= 0) { return 0; }
+        if (radius >= 1) { return maxWarmLength; }
+        return static_cast<size_t>(std::ceil(std::log(decayThreshold) / std::log(radius)));
+    }
+
+    template<typename FloatType>
+    bool ParallelCascade<FloatType>::design() {
+        if (!toDesign.exchange(false)) {
+            return false;
+        }
+        size_t num = 0;
+        {
+            farbot::RealtimeObject<
+                ParallelRequest,
+                farbot::RealtimeObjectOptions::realtimeMutatable>::ScopedAccess<
+                farbot::ThreadType::nonRealtime> rRequest(request);
+            if (rRequest->version == designedVersion) {
+                return false;
+            }
+            num = rRequest->num;
+            designedVersion = rRequest->version;
+            std::copy(rRequest->sections.begin(), rRequest->sections.begin() + static_cast<std::ptrdiff_t>(num),
+                      designSections.begin());
+        }
+        zlIIR::ParallelForm<FloatType>::decompose(designSections.data(), num, designed);
+        designed.version = designedVersion;
+        {
+            farbot::RealtimeObject<
+                zlIIR::ParallelCoeffs,
+                farbot::RealtimeObjectOptions::nonRealtimeMutatable>::ScopedAccess<
+                farbot::ThreadType::nonRealtime> rResult(result);
+            *rResult = designed;
+        }
+        resultVersion.store(designedVersion);
+        return true;
+    }
+
+    template<typename FloatType>
+    ParallelDesigner<FloatType>::ParallelDesigner()
+        : Thread("parallel_designer") {
+    }
+
+    template<typename FloatType>
+    ParallelDesigner<FloatType>::~ParallelDesigner() {
+        if (isThreadRunning()) {
+            stopThread(-1);
+        }
+    }
+
+    template<typename FloatType>
+    void ParallelDesigner<FloatType>::addCascade(ParallelCascade<FloatType> &cascade) {
+        cascades.push_back(&cascade);
+        cascade.setDesigner(this);
+    }
+
+    template<typename FloatType>
+    void ParallelDesigner<FloatType>::setON(const bool x) {
+        isON.store(x);
+        triggerAsyncUpdate();
+    }
+
+    template<typename FloatType>
+    void ParallelDesigner<FloatType>::run() {
+        juce::ScopedNoDenormals noDenormals;
+        while (!threadShouldExit()) {
+            for (auto &cascade: cascades) {
+                cascade->design();
+            }
+            const auto flag = wait(-1);
+            juce::ignoreUnused(flag);
+        }
+    }
+
+    template<typename FloatType>
+    void ParallelDesigner<FloatType>::handleAsyncUpdate() {
+        const auto x = isON.load();
+        if (x && !isThreadRunning()) {
+            startThread(juce::Thread::Priority::low);
+        } else if (!x && isThreadRunning()) {
+            stopThread(-1);
+        }
+    }
+
+    template
+    class ParallelCascade<float>;
+
+    template
+    class ParallelCascade<double>;
+
+    template
+    class ParallelDesigner<float>;
+
+    template
+    class ParallelDesigner<double>;
+}
@@ -0,0 +1,174 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_PARALLEL_CASCADE_HPP
+#define ZLEQUALIZER_PARALLEL_CASCADE_HPP
+
+#include "static_cascade.hpp"
+#include "../farbot/RealtimeObject.hpp"
+
+namespace zlDynamicFilter {
+    template<typename FloatType>
+    class ParallelDesigner;
+
+    /**
+     * the sections of a cascade which should be decomposed into the parallel form
+     */
+    struct ParallelRequest {
+        std::array<zlIIR::coeff33, zlIIR::ParallelCoeffs::maxSections> sections{};
+        size_t num{0};
+        size_t version{0};
+    };
+
+    /**
+     * a cascade of static (non-dynamic) filters on the same channel route, processed in the parallel form
+     * the decomposition is computed on a designer thread, which process wakes up whenever the coefficients change
+     * so a parameter change reaches the parallel form as soon as it is decomposed, usually in the next block
+     * until a valid decomposition is available (or if the cascade cannot be decomposed),
+     * the filters are processed in a static cascade
+     * the states of the two forms are not interchangeable, so a switch cross-fades them: the incoming form
+     * warms up on a copy of the input until the slowest pole has decayed (at most maxWarmSeconds),
+     * then the output fades over to it in rampSeconds
+     * @tparam FloatType
+     */
+    template<typename FloatType>
+    class ParallelCascade {
+    public:
+        static constexpr size_t maxSections = zlIIR::ParallelCoeffs::maxSections;
+
+        /** the longest warm-up of the incoming form during a switch, in seconds */
+        static constexpr double maxWarmSeconds = 0.05;
+
+        /** the length of the fade of a switch after the warm-up, in seconds, as long as a sub buffer */
+        static constexpr double rampSeconds = 0.001;
+
+        /** the warm-up lasts until the slowest pole has decayed below this */
+        static constexpr double decayThreshold = 1e-6;
+
+        ParallelCascade() = default;
+
+        void prepare(const juce::dsp::ProcessSpec &spec);
+
+        /**
+         * check whether a buffer with numChannels channels can be processed in the parallel form
+         * @param numChannels
+         * @return
+         */
+        static bool isAvailable(const size_t numChannels) {
+            return StaticCascade<FloatType>::isAvailable(numChannels) &&
+                   numChannels <= zlIIR::ParallelForm<FloatType>::maxChannels;
+        }
+
+        /**
+         * remove all filters, call it before adding the filters of the current block
+         */
+        void clear();
+
+        /**
+         * reset the states of the parallel form and complete a pending switch between the forms at once
+         * the sections of the static cascade belong to the filters, which are reset on their own
+         */
+        void reset();
+
+        /**
+         * update the parameters of a static filter and append its sections to the cascade
+         * @param filter
+         * @param isBypassed whether the filter is bypassed
+         */
+        void add(IIRFilter<FloatType> &filter, bool isBypassed);
+
+        /**
+         * process the buffer in the parallel form (or in the static cascade)
+         * @param buffer
+         */
+        void process(juce::AudioBuffer<FloatType> &buffer);
+
+        /**
+         * decompose the most recent cascade if it has changed
+         * call it on the designer thread
+         * @return whether a new decomposition has been published
+         */
+        bool design();
+
+        /**
+         * set the designer thread which is woken up when a new decomposition is requested
+         * DO NOT call it while processing
+         * @param x
+         */
+        void setDesigner(ParallelDesigner<FloatType> *x) { designer = x; }
+
+        inline bool getIsParallel() const { return isParallel; }
+
+    private:
+        StaticCascade<FloatType> cascade;
+        zlIIR::ParallelForm<FloatType> form;
+        juce::AudioBuffer<FloatType> fadeBuffer;
+        size_t maxWarmLength{0}, rampLength{2}, warmLength{0}, fadeLength{2}, fadePos{0};
+        bool isFading{false};
+        ParallelDesigner<FloatType> *designer{nullptr};
+
+        // real-time thread
+        std::array<zlIIR::coeff33, maxSections> sections{}, requestedSections{};
+        size_t numSections{0}, numRequested{0};
+        size_t requestVersion{0}, appliedVersion{0};
+        bool isValid{false}, isParallel{false};
+
+        // designer thread
+        std::array<zlIIR::coeff33, maxSections> designSections{};
+        zlIIR::ParallelCoeffs designed;
+        size_t designedVersion{0};
+
+        farbot::RealtimeObject<ParallelRequest, farbot::RealtimeObjectOptions::realtimeMutatable> request;
+        farbot::RealtimeObject<zlIIR::ParallelCoeffs, farbot::RealtimeObjectOptions::nonRealtimeMutatable> result;
+        std::atomic<size_t> resultVersion{0};
+        /** set by the real-time thread when a new request is written, so that it never posts a message */
+        std::atomic<bool> toDesign{false};
+
+        void processForm(bool parallel, juce::AudioBuffer<FloatType> &buffer);
+
+        /**
+         * the number of samples until the slowest pole of the cascade has decayed below decayThreshold
+         * @return
+         */
+        size_t getDecayLength() const;
+    };
+
+    /**
+     * a background thread which computes the parallel form decompositions of parallel cascades
+     * it sleeps until a cascade wakes it up, the async updater only starts and stops the thread
+     * @tparam FloatType
+     */
+    template<typename FloatType>
+    class ParallelDesigner final : private juce::Thread, private juce::AsyncUpdater {
+    public:
+        ParallelDesigner();
+
+        ~ParallelDesigner() override;
+
+        void addCascade(ParallelCascade<FloatType> &cascade);
+
+        void setON(bool x);
+
+        /**
+         * wake up the thread to decompose the cascades which have changed
+         * it only signals an event, it never allocates or posts a message, so it can be called on the real-time thread
+         */
+        void wake() { notify(); }
+
+    private:
+        std::vector<ParallelCascade<FloatType> *> cascades;
+        std::atomic<bool> isON{false};
+
+        void run() override;
+
+        void handleAsyncUpdate() override;
+    };
+}
+
+#endif //ZLEQUALIZER_PARALLEL_CASCADE_HPP
@@ -0,0 +1,144 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include "spectral_side_chain.hpp"
+
+namespace zlDynamicFilter {
+    template<typename FloatType>
+    void SpectralSideChain<FloatType>::prepare(const juce::dsp::ProcessSpec &spec,
+                                               const size_t maximumMomentarySize) {
+        sampleRate = spec.sampleRate;
+        fft = std::make_unique<juce::dsp::FFT>(getFFTOrder(spec.sampleRate));
+        fftSize = static_cast<size_t>(fft->getSize());
+        hopSize = fftSize / hopRatio;
+        binNum = fftSize / 2 + 1;
+        window = std::make_unique<
+            juce::dsp::WindowingFunction<float> >(fftSize, juce::dsp::WindowingFunction<float>::hann, false);
+
+        for (auto &input: inputs) {
+            input.resize(fftSize);
+        }
+        fftData.resize(fftSize * 2);
+        powers.resize(binNum);
+        const auto frameCapacity = maximumMomentarySize / hopSize + 1;
+        for (size_t i = 0; i < maxBands; ++i) {
+            weights[i].resize(binNum);
+            frames[i].resize(frameCapacity);
+        }
+        weightVersions.fill(0);
+        reset();
+    }
+
+    template<typename FloatType>
+    void SpectralSideChain<FloatType>::reset() {
+        for (auto &input: inputs) {
+            std::fill(input.begin(), input.end(), 0.f);
+        }
+        inputPos = 0;
+        hopCount = 0;
+        framePos = 0;
+        frameNums.fill(0);
+        loudness.fill(zlCompressor::RMSTracker<FloatType>::minusInfinityDB);
+    }
+
+    template<typename FloatType>
+    void SpectralSideChain<FloatType>::setBand(const size_t idx, const zlIIR::Filter<FloatType> &sideFilter,
+                                               const bool isON) {
+        if (!isON) {
+            weightVersions[idx] = 0;
+            return;
+        }
+        const auto version = sideFilter.getCoeffVersion() + 1;
+        if (weightVersions[idx] == version) { return; }
+        if (weightVersions[idx] == 0) {
+            frameNums[idx] = 0;
+        }
+        weightVersions[idx] = version;
+        // the window's energy and the one-sided spectrum are folded into the weights, see processFrame
+        std::fill(fftData.begin(), fftData.end(), 0.f);
+        std::fill(fftData.begin(), fftData.begin() + static_cast<std::ptrdiff_t>(fftSize), 1.f);
+        window->multiplyWithWindowingTable(fftData.data(), fftSize);
+        double windowEnergy = 0;
+        for (size_t n = 0; n < fftSize; ++n) {
+            windowEnergy += static_cast<double>(fftData[n]) * static_cast<double>(fftData[n]);
+        }
+        const auto scale = 1.0 / (static_cast<double>(fftSize) * windowEnergy);
+        for (size_t k = 0; k < binNum; ++k) {
+            const auto f = static_cast<double>(k) * sampleRate / static_cast<double>(fftSize);
+            const auto g = zlIIR::ResponseEngine::getGain(sideFilter.getCoeffs(), sideFilter.getFilterNum(),
+                                                          sampleRate, f);
+            const auto fold = (k == 0 || k == binNum - 1) ? 1.0 : 2.0;
+            weights[idx][k] = static_cast<FloatType>(g * g * fold * scale);
+        }
+    }
+
+    template<typename FloatType>
+    void SpectralSideChain<FloatType>::process(const juce::AudioBuffer<FloatType> &buffer,
+                                               const size_t momentarySize) {
+        const auto numChannels = std::min(static_cast<size_t>(buffer.getNumChannels()), inputs.size());
+        for (size_t i = 0; i < static_cast<size_t>(buffer.getNumSamples()); ++i) {
+            for (size_t c = 0; c < numChannels; ++c) {
+                inputs[c][inputPos] = static_cast<float>(buffer.getReadPointer(static_cast<int>(c))[i]);
+            }
+            inputPos = (inputPos + 1) % fftSize;
+            hopCount += 1;
+            if (hopCount == hopSize) {
+                hopCount = 0;
+                // the analysis of the channels is summed, as the mean squares in RMSTracker
+                std::fill(powers.begin(), powers.end(), 0.f);
+                for (size_t c = 0; c < numChannels; ++c) {
+                    std::copy(inputs[c].begin() + static_cast<std::ptrdiff_t>(inputPos), inputs[c].end(),
+                              fftData.begin());
+                    std::copy(inputs[c].begin(), inputs[c].begin() + static_cast<std::ptrdiff_t>(inputPos),
+                              fftData.begin() + static_cast<std::ptrdiff_t>(fftSize - inputPos));
+                    window->multiplyWithWindowingTable(fftData.data(), fftSize);
+                    fft->performFrequencyOnlyForwardTransform(fftData.data(), true);
+                    for (size_t k = 0; k < binNum; ++k) {
+                        powers[k] += fftData[k] * fftData[k];
+                    }
+                }
+                processFrame(momentarySize);
+            }
+        }
+    }
+
+    template<typename FloatType>
+    void SpectralSideChain<FloatType>::processFrame(const size_t momentarySize) {
+        // sum(|X_k|^2) / N is the energy of the windowed frame (Parseval),
+        // which is divided by the energy of the window to get the mean square
+        const auto frameCapacity = frames[0].size();
+        const auto frameNum = std::clamp(momentarySize / hopSize, static_cast<size_t>(1), frameCapacity);
+        for (size_t idx = 0; idx < maxBands; ++idx) {
+            if (weightVersions[idx] == 0) { continue; }
+            FloatType meanSquare = 0;
+            for (size_t k = 0; k < binNum; ++k) {
+                meanSquare += weights[idx][k] * static_cast<FloatType>(powers[k]);
+            }
+            frames[idx][framePos] = meanSquare;
+            frameNums[idx] = std::min(frameNums[idx] + 1, frameCapacity);
+            // the ring is summed from scratch, it holds only a few dozens of frames
+            const auto num = std::min(frameNum, frameNums[idx]);
+            FloatType sum = 0;
+            for (size_t j = 0, pos = framePos; j < num; ++j) {
+                sum += frames[idx][pos];
+                pos = pos == 0 ? frameCapacity - 1 : pos - 1;
+            }
+            loudness[idx] = juce::Decibels::gainToDecibels(
+                                sum / static_cast<FloatType>(num),
+                                zlCompressor::RMSTracker<FloatType>::minusInfinityDB * 2) * FloatType(0.5);
+        }
+        framePos = (framePos + 1) % frameCapacity;
+    }
+
+    template
+    class SpectralSideChain<float>;
+
+    template
+    class SpectralSideChain<double>;
+}
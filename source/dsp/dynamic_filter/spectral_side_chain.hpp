@@ -0,0 +1,114 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_SPECTRAL_SIDE_CHAIN_HPP
+#define ZLEQUALIZER_SPECTRAL_SIDE_CHAIN_HPP
+
+#include <juce_dsp/juce_dsp.h>
+
+#include "../iir_filter/iir_filter.hpp"
+#include "../compressor/compressor.hpp"
+
+namespace zlDynamicFilter {
+    /**
+     * a side chain analysis which estimates the loudness of all dynamic bands on a channel route from one STFT
+     * the power spectrum of each frame is weighted by the squared magnitude responses of the bands' side filters,
+     * so the cost of a band is a dot product over the bins instead of a band-pass filter and a tracker
+     * the frames are Hann windowed and overlap by 7/8, the newest frame is centered half an FFT size behind
+     * the newest sample, which is the latency the main chain should be delayed by
+     * @tparam FloatType
+     */
+    template<typename FloatType>
+    class SpectralSideChain {
+    public:
+        static constexpr size_t maxBands = 16;
+        static constexpr int hopRatio = 8;
+
+        SpectralSideChain() = default;
+
+        /**
+         * get the FFT order at the sample rate, the frame lasts about 10 ms
+         * @param sampleRate
+         * @return
+         */
+        static int getFFTOrder(const double sampleRate) {
+            int extraOrder = 0;
+            if (sampleRate >= 150000) {
+                extraOrder = 2;
+            } else if (sampleRate >= 75000) {
+                extraOrder = 1;
+            }
+            return 9 + extraOrder;
+        }
+
+        /**
+         * get the latency (in samples) of the analysis at the sample rate
+         * @param sampleRate
+         * @return
+         */
+        static int getLatencySamples(const double sampleRate) {
+            return (1 << getFFTOrder(sampleRate)) / 2;
+        }
+
+        /**
+         * allocate the buffers
+         * @param spec
+         * @param maximumMomentarySize the maximum momentary size (in samples) of the trackers
+         */
+        void prepare(const juce::dsp::ProcessSpec &spec, size_t maximumMomentarySize);
+
+        void reset();
+
+        /**
+         * update the spectral weights of a band if the coefficients of its side filter have changed
+         * call it on the audio thread, where the side filter is updated
+         * @param idx band index
+         * @param sideFilter
+         * @param isON whether the band is analyzed
+         */
+        void setBand(size_t idx, const zlIIR::Filter<FloatType> &sideFilter, bool isON);
+
+        /**
+         * push the side chain buffer and analyze the frames which are completed
+         * @param buffer side chain audio buffer of the route
+         * @param momentarySize the momentary size (in samples) which the loudness is averaged over
+         */
+        void process(const juce::AudioBuffer<FloatType> &buffer, size_t momentarySize);
+
+        /**
+         * @param idx band index
+         * @return the momentary loudness (in dB) of the band, on the same scale as RMSTracker
+         */
+        FloatType getLoudness(const size_t idx) const { return loudness[idx]; }
+
+    private:
+        std::unique_ptr<juce::dsp::FFT> fft;
+        std::unique_ptr<juce::dsp::WindowingFunction<float> > window;
+        size_t fftSize{0}, hopSize{0}, binNum{0};
+        double sampleRate{48000};
+
+        std::array<std::vector<float>, 2> inputs;
+        size_t inputPos{0}, hopCount{0};
+        std::vector<float> fftData, powers;
+
+        std::array<std::vector<FloatType>, maxBands> weights;
+        /** the coefficient versions (plus one) which the weights are designed from, zero if the band is off */
+        std::array<size_t, maxBands> weightVersions{};
+
+        /** the mean squares of the latest frames of each band, in a ring */
+        std::array<std::vector<FloatType>, maxBands> frames;
+        size_t framePos{0};
+        std::array<size_t, maxBands> frameNums{};
+        std::array<FloatType, maxBands> loudness{};
+
+        void processFrame(size_t momentarySize);
+    };
+}
+
+#endif //ZLEQUALIZER_SPECTRAL_SIDE_CHAIN_HPP
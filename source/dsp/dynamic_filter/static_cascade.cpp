@@ -0,0 +1,141 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include "static_cascade.hpp"
+
+namespace zlDynamicFilter {
+    template<typename FloatType>
+    void StaticCascade<FloatType>::clear() {
+        numFilters = 0;
+        numSections = 0;
+    }
+
+    template<typename FloatType>
+    void StaticCascade<FloatType>::add(IIRFilter<FloatType> &filter, const bool isBypassed) {
+        jassert(numFilters < maxFilters);
+        const auto isSectionBypassed = filter.prepareStatic(isBypassed);
+        filters[numFilters] = &filter;
+        filterBypass[numFilters] = isBypassed;
+        numFilters += 1;
+
+        auto &mFilter = filter.getMainFilter();
+        const auto num = mFilter.getFilterNum();
+        for (size_t i = 0; i < num; ++i) {
+            auto &section = sections[numSections];
+            if (mFilter.getCurrentSVFON()) {
+                section.iir = nullptr;
+                section.svf = &mFilter.getSVFFilters()[i];
+            } else {
+                section.iir = &mFilter.getFilters()[i];
+                section.svf = nullptr;
+            }
+            section.isBypassed = isSectionBypassed;
+            section.filterIdx = numFilters - 1;
+            numSections += 1;
+        }
+    }
+
+    template<typename FloatType>
+    void StaticCascade<FloatType>::process(juce::AudioBuffer<FloatType> &buffer) {
+        processSections(buffer);
+        finish(buffer);
+    }
+
+    template<typename FloatType>
+    void StaticCascade<FloatType>::processSections(juce::AudioBuffer<FloatType> &buffer) {
+        auto block = juce::dsp::AudioBlock<FloatType>(buffer);
+        const auto numSamples = block.getNumSamples();
+        jassert(isAvailable(block.getNumChannels()));
+        // check the input of the route once, and only if a filter may wake up or go idle
+        bool needsInputCheck = false;
+        for (size_t i = 0; i < numFilters && !needsInputCheck; ++i) {
+            needsInputCheck = filters[i]->getMainFilter().needsInputCheck();
+        }
+        const auto isInputSilent = needsInputCheck && zlIIR::Filter<FloatType>::isSilent(buffer);
+        // drop the sections of idle filters, the input of a filter is silent only if the filters before it are idle,
+        // otherwise their tails are still ringing
+        auto isSilentSoFar = isInputSilent;
+        for (size_t i = 0; i < numFilters; ++i) {
+            filterIdle[i] = filters[i]->getMainFilter().skipIdle(isSilentSoFar);
+            isSilentSoFar = isSilentSoFar && filterIdle[i];
+        }
+        size_t numActive = 0;
+        for (size_t i = 0; i < numSections; ++i) {
+            if (!filterIdle[sections[i].filterIdx]) {
+                sections[numActive] = sections[i];
+                numActive += 1;
+            }
+        }
+        numSections = numActive;
+        if (numSections > 0) {
+            for (size_t start = 0; start < numSamples; start += zlIIR::Lanes<FloatType>::tileSize) {
+                const auto n = std::min(zlIIR::Lanes<FloatType>::tileSize, numSamples - start);
+                zlIIR::Lanes<FloatType>::toTile(block, start, n, tile.data());
+                for (size_t i = 0; i < numSections; ++i) {
+                    const auto &section = sections[i];
+                    if (section.iir != nullptr) {
+                        if (section.isBypassed) {
+                            section.iir->template processTile<true>(tile.data(), n);
+                        } else {
+                            section.iir->template processTile<false>(tile.data(), n);
+                        }
+                    } else {
+                        if (section.isBypassed) {
+                            section.svf->template processTile<true>(tile.data(), n);
+                        } else {
+                            section.svf->template processTile<false>(tile.data(), n);
+                        }
+                    }
+                }
+                zlIIR::Lanes<FloatType>::fromTile(tile.data(), start, n, block);
+            }
+#if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+            for (size_t i = 0; i < numSections; ++i) {
+                if (sections[i].iir != nullptr) {
+                    sections[i].iir->snapToZero();
+                } else {
+                    sections[i].svf->snapToZero();
+                }
+            }
+#endif
+        }
+        isSilentSoFar = isInputSilent;
+        for (size_t i = 0; i < numFilters; ++i) {
+            auto &mFilter = filters[i]->getMainFilter();
+            if (!filterIdle[i]) {
+                mFilter.updateIdle(isSilentSoFar);
+            }
+            isSilentSoFar = isSilentSoFar && mFilter.getIsIdle();
+        }
+    }
+
+    template<typename FloatType>
+    void StaticCascade<FloatType>::finish(juce::AudioBuffer<FloatType> &buffer) {
+        for (size_t i = 0; i < numFilters; ++i) {
+            filters[i]->finishStatic(buffer, filterBypass[i]);
+        }
+    }
+
+    template<typename FloatType>
+    void StaticCascade<FloatType>::resetSections() {
+        for (size_t i = 0; i < numSections; ++i) {
+            if (sections[i].iir != nullptr) {
+                sections[i].iir->reset();
+            } else {
+                sections[i].svf->reset();
+            }
+        }
+    }
+
+    template
+    class StaticCascade<float>;
+
+    template
+    class StaticCascade<double>;
+}
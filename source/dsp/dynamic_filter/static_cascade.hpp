@@ -0,0 +1,97 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_STATIC_CASCADE_HPP
+#define ZLEQUALIZER_STATIC_CASCADE_HPP
+
+#include "dynamic_iir_filter.hpp"
+
+namespace zlDynamicFilter {
+    /**
+     * a flattened cascade of static (non-dynamic) filters on the same channel route
+     * the 2nd order sections of all filters are packed into one list (in the order of filters)
+     * and processed in one fused pass, so that the buffer is swept once instead of once per filter
+     * the sections of idle filters are dropped from the pass while the input is silent
+     * @tparam FloatType
+     */
+    template<typename FloatType>
+    class StaticCascade {
+    public:
+        static constexpr size_t maxFilters = 16;
+        static constexpr size_t maxSections = maxFilters * 16;
+
+        StaticCascade() = default;
+
+        /**
+         * check whether a buffer with numChannels channels can be processed in the fused pass
+         * @param numChannels
+         * @return
+         */
+        static bool isAvailable(const size_t numChannels) {
+            return zlIIR::Lanes<FloatType>::isSupported() && numChannels <= zlIIR::Lanes<FloatType>::size;
+        }
+
+        /**
+         * remove all filters, call it before adding the filters of the current block
+         */
+        void clear();
+
+        /**
+         * update the parameters of a static filter and append its sections to the cascade
+         * @param filter
+         * @param isBypassed whether the filter is bypassed
+         */
+        void add(IIRFilter<FloatType> &filter, bool isBypassed);
+
+        /**
+         * process the buffer through all sections in one pass
+         * @param buffer
+         */
+        void process(juce::AudioBuffer<FloatType> &buffer);
+
+        /**
+         * process the buffer through all sections in one pass, without the gain compensation
+         * @param buffer
+         */
+        void processSections(juce::AudioBuffer<FloatType> &buffer);
+
+        /**
+         * apply the per-filter gain compensation, call it after the sections have been processed
+         * it is called by process
+         * @param buffer
+         */
+        void finish(juce::AudioBuffer<FloatType> &buffer);
+
+        /**
+         * reset the states of all sections in the cascade
+         */
+        void resetSections();
+
+        inline size_t getNumSections() const { return numSections; }
+
+    private:
+        struct Section {
+            zlIIR::IIRBase<FloatType> *iir{nullptr};
+            zlIIR::SVFBase<FloatType> *svf{nullptr};
+            bool isBypassed{false};
+            size_t filterIdx{0};
+        };
+
+        std::array<IIRFilter<FloatType> *, maxFilters> filters{};
+        std::array<bool, maxFilters> filterBypass{}, filterIdle{};
+        size_t numFilters{0};
+
+        std::array<Section, maxSections> sections{};
+        size_t numSections{0};
+
+        alignas(zlIIR::Lanes<FloatType>::alignment) typename zlIIR::Lanes<FloatType>::Tile tile{};
+    };
+}
+
+#endif //ZLEQUALIZER_STATIC_CASCADE_HPP
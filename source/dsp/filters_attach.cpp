@@ -200,13 +200,13 @@ namespace zlDSP {
         } else if (parameterID.startsWith(kneeW::ID)) {
             filtersRef[idx].getCompressor().getComputer().setKneeW(kneeW::formatV(value));
         } else if (parameterID.startsWith(sideFreq::ID)) {
-            filtersRef[idx].getSideFilter().setFreq(value);
+            controllerRef.setSideFreq(value, idx);
         } else if (parameterID.startsWith(attack::ID)) {
             filtersRef[idx].getCompressor().getDetector().setAttack(value);
         } else if (parameterID.startsWith(release::ID)) {
             filtersRef[idx].getCompressor().getDetector().setRelease(value);
         } else if (parameterID.startsWith(sideQ::ID)) {
-            filtersRef[idx].getSideFilter().setQ(value);
+            controllerRef.setSideQ(value, idx);
         } else if (parameterID.startsWith(singleDynLink::ID)) {
             sDynLink[idx].store(static_cast<bool>(newValue));
             checkUpdateSide(idx);
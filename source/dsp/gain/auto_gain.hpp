@@ -35,6 +35,14 @@ namespace zlGain {
 
         void setRampDurationSeconds(double newDurationSeconds);
 
+        /**
+         * reset the gain to unity at the next block
+         */
+        void reset() {
+            toReset.store(true);
+            isPreProcessed.store(false);
+        }
+
         void enable(bool f);
 
     private:
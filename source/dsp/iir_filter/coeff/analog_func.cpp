@@ -42,13 +42,75 @@ namespace zlIIR {
         return get2Magnitude2({1, std::sqrt(A) * w0 / q, A * w0 * w0, A, std::sqrt(A) * w0 / q, w0 * w0}, w);
     }
 
-//    double AnalogFunc::get2LowShelfMagnitude2(double w0, double g, double q, double w) {
-//        auto A = std::sqrt(g);
-//        return get2Magnitude2({A, A * std::sqrt(A) * w0 / q, A * A * w0 * w0, A, std::sqrt(A) * w0 / q, A * w0 * w0}, w);
-//    }
-//
-//    double AnalogFunc::get2HighShelfMagnitude2(double w0, double g, double q, double w) {
-//        auto A = std::sqrt(g);
-//        return get2Magnitude2({1, std::sqrt(A) * w0 / q, w0 * w0, A * A, A * std::sqrt(A) * w0 / q, A * w0 * w0}, w);
-//    }
-}
\ No newline at end of file
+    double AnalogFunc::get2LowShelfMagnitude2(double w0, double g, double q, double w) {
+        return get2TiltShelfMagnitude2(w0, 1 / g, q, w) * g;
+    }
+
+    double AnalogFunc::get2HighShelfMagnitude2(double w0, double g, double q, double w) {
+        return get2TiltShelfMagnitude2(w0, g, q, w) * g;
+    }
+
+    coeff22 AnalogFunc::get1LowPass(double w0) {
+        return {{w0, 1}, {w0, 0}};
+    }
+
+    coeff22 AnalogFunc::get1HighPass(double w0) {
+        return {{w0, 1}, {0, 1}};
+    }
+
+    coeff22 AnalogFunc::get1TiltShelf(double w0, double g) {
+        // the pole at w0 * sqrt(g), the zero at w0 / sqrt(g), 1/sqrt(g) at DC and sqrt(g) at infinity
+        auto A = std::sqrt(std::sqrt(g));
+        return {{w0 * A, 1 / A}, {w0 / A, A}};
+    }
+
+    coeff22 AnalogFunc::get1LowShelf(double w0, double g) {
+        auto [a, b] = get1TiltShelf(w0, 1 / g);
+        auto A = std::sqrt(g);
+        return {a, {b[0] * A, b[1] * A}};
+    }
+
+    coeff22 AnalogFunc::get1HighShelf(double w0, double g) {
+        auto [a, b] = get1TiltShelf(w0, g);
+        auto A = std::sqrt(g);
+        return {a, {b[0] * A, b[1] * A}};
+    }
+
+    coeff33 AnalogFunc::get2LowPass(double w0, double q) {
+        return {{w0 * w0, w0 / q, 1}, {w0 * w0, 0, 0}};
+    }
+
+    coeff33 AnalogFunc::get2HighPass(double w0, double q) {
+        return {{w0 * w0, w0 / q, 1}, {0, 0, 1}};
+    }
+
+    coeff33 AnalogFunc::get2BandPass(double w0, double q) {
+        return {{w0 * w0, w0 / q, 1}, {0, w0 / q, 0}};
+    }
+
+    coeff33 AnalogFunc::get2Notch(double w0, double q) {
+        return {{w0 * w0, w0 / q, 1}, {w0 * w0, 0, 1}};
+    }
+
+    coeff33 AnalogFunc::get2Peak(double w0, double g, double q) {
+        auto A = std::sqrt(g);
+        return {{w0 * w0, w0 / A / q, 1}, {w0 * w0, w0 * A / q, 1}};
+    }
+
+    coeff33 AnalogFunc::get2TiltShelf(double w0, double g, double q) {
+        auto A = std::sqrt(g);
+        return {{A * w0 * w0, std::sqrt(A) * w0 / q, 1}, {w0 * w0, std::sqrt(A) * w0 / q, A}};
+    }
+
+    coeff33 AnalogFunc::get2LowShelf(double w0, double g, double q) {
+        auto [a, b] = get2TiltShelf(w0, 1 / g, q);
+        auto A = std::sqrt(g);
+        return {a, {b[0] * A, b[1] * A, b[2] * A}};
+    }
+
+    coeff33 AnalogFunc::get2HighShelf(double w0, double g, double q) {
+        auto [a, b] = get2TiltShelf(w0, g, q);
+        auto A = std::sqrt(g);
+        return {a, {b[0] * A, b[1] * A, b[2] * A}};
+    }
+}
@@ -20,8 +20,49 @@ namespace zlIIR {
     using coeff22 = std::tuple<coeff2, coeff2>;
     using coeff33 = std::tuple<coeff3, coeff3>;
 
+    /**
+     * closed-form responses of the analog prototypes that MartinCoeff matches
+     * the prototype sections are stored like the digital ones, {a, b} with a the denominator and b the numerator,
+     * but as polynomials in ascending powers of s, where s is normalized by the sample rate (s = jw, w = 2pi f / fs)
+     */
     class AnalogFunc {
     public:
+        static coeff22 get1LowPass(double w0);
+
+        static coeff22 get1HighPass(double w0);
+
+        static coeff22 get1TiltShelf(double w0, double g);
+
+        static coeff22 get1LowShelf(double w0, double g);
+
+        static coeff22 get1HighShelf(double w0, double g);
+
+        static coeff33 get2LowPass(double w0, double q);
+
+        static coeff33 get2HighPass(double w0, double q);
+
+        static coeff33 get2BandPass(double w0, double q);
+
+        static coeff33 get2Notch(double w0, double q);
+
+        static coeff33 get2Peak(double w0, double g, double q);
+
+        static coeff33 get2TiltShelf(double w0, double g, double q);
+
+        static coeff33 get2LowShelf(double w0, double g, double q);
+
+        static coeff33 get2HighShelf(double w0, double g, double q);
+
+        /**
+         * the squared magnitude of a polynomial in ascending powers of s at s = jw
+         * @param p
+         * @param w2 w^2
+         * @return
+         */
+        static double getMagnitude2(const coeff3 &p, const double w2) {
+            return (p[0] - p[2] * w2) * (p[0] - p[2] * w2) + p[1] * p[1] * w2;
+        }
+
         static double get2LowPassMagnitude2(double w0, double q, double w);
 
         static double get2HighPassMagnitude2(double w0, double q, double w);
@@ -0,0 +1,94 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include "coeff_cache.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace zlIIR {
+    size_t CoeffCache::updateCoeff(const FilterType filterType,
+                                   const double f, const double fs,
+                                   const double gDB, const double q,
+                                   const size_t n, std::array<coeff33, 16> &coeffs,
+                                   const bool useFastMath) {
+        const auto key = quantize({filterType, f, fs, gDB, q, n, useFastMath});
+        auto &entry = entries[hash(key) & (capacity - 1)];
+        if (entry.valid && entry.key == key) {
+            hits.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            const auto spec = dequantize(key);
+            // the same design as prefetch, so that a key holds the same coefficients whether it was prefetched or not
+            DesignFilter::updateCoeffBatch(&spec, 1, &entry.coeffs, &entry.num);
+            entry.key = key;
+            entry.valid = true;
+            misses.fetch_add(1, std::memory_order_relaxed);
+        }
+        std::copy_n(entry.coeffs.begin(), entry.num, coeffs.begin());
+        return entry.num;
+    }
+
+    void CoeffCache::prefetch(const DesignSpec *specs, const size_t num) {
+        size_t count = 0;
+        const auto flush = [&]() {
+            DesignFilter::updateCoeffBatch(prefetchSpecs.data(), count, prefetchCoeffs.data(), prefetchNums.data());
+            for (size_t i = 0; i < count; ++i) {
+                const auto key = quantize(prefetchSpecs[i]);
+                auto &entry = entries[hash(key) & (capacity - 1)];
+                std::copy_n(prefetchCoeffs[i].begin(), prefetchNums[i], entry.coeffs.begin());
+                entry.num = prefetchNums[i];
+                entry.key = key;
+                entry.valid = true;
+            }
+            misses.fetch_add(count, std::memory_order_relaxed);
+            count = 0;
+        };
+        for (size_t i = 0; i < num; ++i) {
+            const auto key = quantize(specs[i]);
+            const auto &entry = entries[hash(key) & (capacity - 1)];
+            if (entry.valid && entry.key == key) { continue; }
+            prefetchSpecs[count] = dequantize(key);
+            count += 1;
+            if (count == prefetchSize) { flush(); }
+        }
+        if (count > 0) { flush(); }
+    }
+
+    void CoeffCache::clear() {
+        for (auto &entry: entries) {
+            entry.valid = false;
+        }
+    }
+
+    CoeffCache::Key CoeffCache::quantize(const DesignSpec &spec) {
+        return {
+            spec.filterType, spec.n, spec.useFastMath, spec.fs,
+            std::llround(spec.f * freqScale), std::llround(spec.gDB * gainScale), std::llround(spec.q * qScale)
+        };
+    }
+
+    DesignSpec CoeffCache::dequantize(const Key &key) {
+        return {
+            key.filterType, static_cast<double>(key.f) / freqScale, key.fs,
+            static_cast<double>(key.gDB) / gainScale, static_cast<double>(key.q) / qScale, key.n,
+            key.useFastMath
+        };
+    }
+
+    size_t CoeffCache::hash(const Key &key) {
+        size_t h = std::hash<double>{}(key.fs);
+        for (const auto v: {
+                 static_cast<long long>(key.filterType), static_cast<long long>(key.n),
+                 static_cast<long long>(key.useFastMath), key.f, key.gDB, key.q
+             }) {
+            h ^= std::hash<long long>{}(v) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+        }
+        return h;
+    }
+}
@@ -0,0 +1,102 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_COEFF_CACHE_HPP
+#define ZLEQUALIZER_COEFF_CACHE_HPP
+
+#include <atomic>
+#include "design_filter.hpp"
+
+namespace zlIIR {
+    /**
+     * a bounded, direct-mapped cache of designed coefficients, keyed on quantized parameters
+     * the parameters are always quantized before the design (on hits and misses), and both prefetch and misses
+     * design through DesignFilter::updateCoeffBatch, so that the coefficients do not depend on the state of the cache
+     * it is only accessed on the real-time thread: a lookup never waits, and a miss is designed in place
+     */
+    class CoeffCache {
+    public:
+        /** the number of entries, must be a power of 2 */
+        static constexpr size_t capacity = 256;
+
+        /** quantization steps: 0.01 Hz, 0.001 dB and 0.0001 */
+        static constexpr double freqScale = 100.0, gainScale = 1000.0, qScale = 10000.0;
+
+        CoeffCache() = default;
+
+        /**
+         * update an array of 2nd order filter coeffs, from the cache if possible
+         * @param filterType filter type
+         * @param f frequency
+         * @param fs sample rate
+         * @param gDB gain
+         * @param q Q
+         * @param n filter order
+         * @param coeffs the array of coeffs
+         * @param useFastMath whether to use the approximated transcendental functions (see FastMath)
+         * @return the actual filter size
+         */
+        size_t updateCoeff(FilterType filterType,
+                           double f, double fs, double gDB, double q, size_t n, std::array<coeff33, 16> &coeffs,
+                           bool useFastMath = false);
+
+        /**
+         * design the coefficients of the specs that are not cached yet, in batches (see DesignFilter::updateCoeffBatch)
+         * the following updateCoeff calls with the same parameters are hits
+         * @param specs
+         * @param num the number of specs
+         */
+        void prefetch(const DesignSpec *specs, size_t num);
+
+        /**
+         * invalidate all entries
+         * DO NOT call it outside the real-time thread
+         */
+        void clear();
+
+        size_t getHits() const { return hits.load(std::memory_order_relaxed); }
+
+        size_t getMisses() const { return misses.load(std::memory_order_relaxed); }
+
+    private:
+        struct Key {
+            FilterType filterType{peak};
+            size_t n{0};
+            bool useFastMath{false};
+            double fs{0};
+            long long f{0}, gDB{0}, q{0};
+
+            bool operator==(const Key &other) const = default;
+        };
+
+        struct Entry {
+            Key key;
+            bool valid{false};
+            size_t num{0};
+            std::array<coeff33, 16> coeffs{};
+        };
+
+        /** the number of specs designed by one batch call of prefetch */
+        static constexpr size_t prefetchSize = 32;
+
+        std::array<Entry, capacity> entries{};
+        std::array<DesignSpec, prefetchSize> prefetchSpecs{};
+        std::array<std::array<coeff33, 16>, prefetchSize> prefetchCoeffs{};
+        std::array<size_t, prefetchSize> prefetchNums{};
+        std::atomic<size_t> hits{0}, misses{0};
+
+        static Key quantize(const DesignSpec &spec);
+
+        static DesignSpec dequantize(const Key &key);
+
+        static size_t hash(const Key &key);
+    };
+}
+
+#endif //ZLEQUALIZER_COEFF_CACHE_HPP
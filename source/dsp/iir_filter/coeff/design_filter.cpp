@@ -13,387 +13,382 @@
 
 #include "design_filter.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
 const static double pi = std::numbers::pi;
 const static double ppi = 2 * std::numbers::pi;
 
-namespace zlIIR {
-    std::vector<coeff33> DesignFilter::getCoeff(zlIIR::FilterType filterType,
-                                                double f, double fs, double gDB, double q, size_t n) {
-        auto w0 = ppi * f / fs;
-        auto g = db_to_gain(gDB);
-        switch (filterType) {
-            case peak:
-                switch (n) {
-                    case 0:
-                    case 1: return {coeff33{{1, 1, 1}, {1, 1, 1}}};
-                    case 2: return getPeak(w0, g, q);
-                    default: return getBandShelf(n, w0, g, q);
-                }
-            case lowShelf:
-                return getLowShelf(n, w0, g, std::sqrt(q * std::sqrt(2)) / std::sqrt(2));
-            case lowPass:
-                return getLowPass(n, w0, q);
-            case highShelf:
-                return getHighShelf(n, w0, g, std::sqrt(q * std::sqrt(2)) / std::sqrt(2));
-            case highPass:
-                return getHighPass(n, w0, q);
-            case bandShelf:
-                return getBandShelf(n, w0, g, q);
-            case tiltShelf:
-                return getTiltShelf(n, w0, g, std::sqrt(q * std::sqrt(2)) / std::sqrt(2));
-            case notch:
-                return getNotch(n, w0, q);
-            case bandPass:
-                return getBandPass(n, w0, q);
-            default:
-                return {coeff33{{1, 1, 1}, {1, 1, 1}}};
+namespace {
+    /**
+     * Q values of the 2nd order sections of Butterworth filters, the i-th Q of m sections is stored at [m][i]
+     * they are computed with std::cos at static initialization, so that they match the per-call values bit by bit
+     */
+    auto makeButterworthQs() {
+        std::array<std::array<double, zlIIR::DesignFilter::maxSections>,
+            zlIIR::DesignFilter::maxSections + 1> qs{};
+        for (size_t m = 1; m <= zlIIR::DesignFilter::maxSections; ++m) {
+            const auto theta0 = std::numbers::pi / static_cast<double>(m) / 4;
+            for (size_t i = 0; i < m; ++i) {
+                qs[m][i] = 1.0 / 2.0 / std::cos(theta0 * static_cast<double>(2 * i + 1));
+            }
         }
+        return qs;
+    }
+
+    const auto butterworthQs = makeButterworthQs();
+
+    /**
+     * round to the nearest integer for |x| < 2^30, with a truncating int conversion
+     * unlike std::nearbyint, it is not a library call, so that a loop over lanes vectorizes (also with -Ofast)
+     */
+    inline double batchRound(const double x) {
+        constexpr double offset = 1073741824.0;
+        return static_cast<double>(static_cast<int>(x + (offset + 0.5))) - offset;
+    }
+
+    /**
+     * exp on [-700, 700], x = k * ln2 + r with |r| <= ln2 / 2 (Cody-Waite), exp(r) = 1 + 2r / (2 - c)
+     * c = r - r^2 * P(r^2) is the minimax rational approximation of fdlibm, P has degree 4 (error < 2^-59)
+     */
+    inline double batchExp(double x) {
+        constexpr double ln2Hi = 6.93147180369123816490e-01, ln2Lo = 1.90821492927058770002e-10;
+        constexpr double p1 = 1.66666666666666019037e-01, p2 = -2.77777777770155933842e-03,
+                p3 = 6.61375632143793436117e-05, p4 = -1.65339022054652515390e-06,
+                p5 = 4.13813679705723846039e-08;
+        // 2^52 + 1023, the lowest bits of (k + shift) hold the biased exponent k + 1023
+        constexpr double shift = 4503599627370496.0 + 1023.0;
+        x = std::min(std::max(x, -700.0), 700.0);
+        const auto k = batchRound(x * std::numbers::log2e);
+        const auto hi = x - k * ln2Hi, lo = k * ln2Lo;
+        const auto r = hi - lo;
+        const auto z = r * r;
+        const auto c = r - z * (p1 + z * (p2 + z * (p3 + z * (p4 + z * p5))));
+        const auto y = 1.0 - ((lo - (r * c) / (2.0 - c)) - hi);
+        return y * std::bit_cast<double>(std::bit_cast<std::uint64_t>(k + shift) << 52);
+    }
+
+    /**
+     * sin on [0, pi/2], sin(x) on [0, pi/4] and cos(pi/2 - x) on [pi/4, pi/2]
+     * with the minimax polynomials of fdlibm, of degree 13 and 14 (error < 2^-58)
+     * both are evaluated and one is selected, so that a loop over lanes vectorizes
+     */
+    inline double batchSin(const double x) {
+        constexpr double s1 = -1.66666666666666324348e-01, s2 = 8.33333333332248946124e-03,
+                s3 = -1.98412698298579493134e-04, s4 = 2.75573137070700676789e-06,
+                s5 = -2.50507602534068634195e-08, s6 = 1.58969099521155010221e-10;
+        constexpr double c1 = 4.16666666666666019037e-02, c2 = -1.38888888888741095749e-03,
+                c3 = 2.48015872894767294178e-05, c4 = -2.75573143513906633035e-07,
+                c5 = 2.08757232129817482790e-09, c6 = -1.13596475577881948265e-11;
+        constexpr double piHalfHi = 1.57079632679489655800e+00, piHalfLo = 6.12323399573676603587e-17;
+        const auto zs = x * x;
+        const auto sinX = x + x * zs * (s1 + zs * (s2 + zs * (s3 + zs * (s4 + zs * (s5 + zs * s6)))));
+        const auto y = (piHalfHi - x) + piHalfLo;
+        const auto zc = y * y;
+        const auto cosY = 1.0 - 0.5 * zc + zc * zc * (c1 + zc * (c2 + zc * (c3 + zc * (c4 + zc * (c5 + zc * c6)))));
+        return x <= 0.25 * std::numbers::pi ? sinX : cosY;
     }
+}
 
+namespace zlIIR {
     size_t DesignFilter::updateCoeff(const FilterType filterType,
+        const double f, const double fs,
+        const double gDB, const double q,
+        const size_t n, std::array<coeff33, 16> &coeffs,
+        const bool useFastMath) {
+        if (useFastMath) {
+            return designCoeff<FastMath, MartinCoeff<FastMath>>(filterType, f, fs, gDB, q, n, coeffs);
+        } else {
+            return designCoeff<ExactMath, MartinCoeff<ExactMath>>(filterType, f, fs, gDB, q, n, coeffs);
+        }
+    }
+
+    size_t DesignFilter::updateAnalogCoeff(const FilterType filterType,
+        const double f, const double fs,
+        const double gDB, const double q,
+        const size_t n, std::array<coeff33, 16> &coeffs) {
+        return designCoeff<ExactMath, AnalogFunc>(filterType, f, fs, gDB, q, n, coeffs);
+    }
+
+    template<typename Math, typename Coeff>
+    size_t DesignFilter::designCoeff(const FilterType filterType,
         const double f, const double fs,
         const double gDB, const double q,
         const size_t n, std::array<coeff33, 16> &coeffs) {
         auto w0 = ppi * f / fs;
-        auto g = db_to_gain(gDB);
+        auto g = Math::dbToGain(gDB);
         switch (filterType) {
             case peak:
                 switch (n) {
                     case 0:
                     case 1: return 0;
-                    case 2: return updatePeak(w0, g, q, coeffs);
-                    default: return updateBandShelf(n, w0, g, q, coeffs, 0);
+                    case 2: return updatePeak<Math, Coeff>(w0, g, q, coeffs);
+                    default: return updateBandShelf<Math, Coeff>(n, w0, g, q, coeffs, 0);
                 }
             case lowShelf:
-                return updateLowShelf(n, w0, g, std::sqrt(q * std::sqrt(2)) / std::sqrt(2), coeffs, 0);
+                return updateLowShelf<Math, Coeff>(n, w0, g, std::sqrt(q * std::sqrt(2)) / std::sqrt(2), coeffs, 0);
             case lowPass:
-                return updateLowPass(n, w0, q, coeffs, 0);
+                return updateLowPass<Math, Coeff>(n, w0, q, coeffs, 0);
             case highShelf:
-                return updateHighShelf(n, w0, g, std::sqrt(q * std::sqrt(2)) / std::sqrt(2), coeffs, 0);
+                return updateHighShelf<Math, Coeff>(n, w0, g, std::sqrt(q * std::sqrt(2)) / std::sqrt(2), coeffs, 0);
             case highPass:
-                return updateHighPass(n, w0, q, coeffs, 0);
+                return updateHighPass<Math, Coeff>(n, w0, q, coeffs, 0);
             case bandShelf:
-                return updateBandShelf(n, w0, g, q, coeffs, 0);
+                return updateBandShelf<Math, Coeff>(n, w0, g, q, coeffs, 0);
             case tiltShelf:
-                return updateTiltShelf(n, w0, g, std::sqrt(q * std::sqrt(2)) / std::sqrt(2), coeffs, 0);
+                return updateTiltShelf<Math, Coeff>(n, w0, g, std::sqrt(q * std::sqrt(2)) / std::sqrt(2), coeffs, 0);
             case notch:
-                return updateNotch(n, w0, q, coeffs, 0);
+                return updateNotch<Math, Coeff>(n, w0, q, coeffs, 0);
             case bandPass:
-                return updateBandPass(n, w0, q, coeffs, 0);
+                return updateBandPass<Math, Coeff>(n, w0, q, coeffs, 0);
             default:
                 return 0;
         }
     }
 
 
-    std::vector<coeff33> DesignFilter::getLowPass(size_t n, double w0, double q) {
-        if (n == 1) {
-            auto [a, b] = MartinCoeff::get1LowPass(w0);
-            return {{{a[0], a[1], 0.0}, {b[0], b[1], 0.0}}};
-        } else {
-            auto qs = getQs(n, q);
-            std::vector<coeff33> coeff;
-            coeff.reserve(qs.size());
-            for (auto _q: qs) {
-                coeff.push_back(MartinCoeff::get2LowPass(w0, _q));
+    void DesignFilter::updateCoeffBatch(const DesignSpec *specs, const size_t num,
+                                        std::array<coeff33, 16> *coeffs, size_t *nums) {
+        std::array<size_t, batchLanes> idx{};
+        std::array<double, batchLanes> w0{}, g{}, q{};
+        std::array<coeff33, batchLanes> peakCoeffs{};
+        size_t lane = 0;
+        const auto flush = [&]() {
+            // fill the unused lanes with the first filter
+            for (size_t l = lane; l < batchLanes; ++l) {
+                w0[l] = w0[0];
+                g[l] = g[0];
+                q[l] = q[0];
             }
-            return coeff;
-        }
-    }
-
-    std::vector<coeff33> DesignFilter::getHighPass(size_t n, double w0, double q) {
-        if (n == 1) {
-            auto [a, b] = MartinCoeff::get1HighPass(w0);
-            return {{{a[0], a[1], 0.0}, {b[0], b[1], 0.0}}};
-        } else {
-            auto qs = getQs(n, q);
-            std::vector<coeff33> coeff;
-            coeff.reserve(qs.size());
-            for (auto _q: qs) {
-                coeff.push_back(MartinCoeff::get2HighPass(w0, _q));
+            updatePeakBatch(w0, g, q, peakCoeffs);
+            for (size_t l = 0; l < lane; ++l) {
+                coeffs[idx[l]][0] = peakCoeffs[l];
+                nums[idx[l]] = 1;
             }
-            return coeff;
-        }
-    }
-
-    std::vector<coeff33> DesignFilter::getTiltShelf(size_t n, double w0, double g, double q) {
-        if (n == 1) {
-            auto [a, b] = MartinCoeff::get1TiltShelf(w0, g);
-            return {{{a[0], a[1], 0.0}, {b[0], b[1], 0.0}}};
-        } else {
-            auto qs = getQs(n, q);
-            auto _g = std::pow(g, 1.0 / static_cast<double>(qs.size()));
-            std::vector<coeff33> coeff;
-            coeff.reserve(qs.size());
-            for (auto _q: qs) {
-                coeff.push_back(MartinCoeff::get2TiltShelf(w0, _g, _q));
+            lane = 0;
+        };
+        for (size_t i = 0; i < num; ++i) {
+            const auto &spec = specs[i];
+            if (spec.filterType == peak && spec.n == 2) {
+                idx[lane] = i;
+                w0[lane] = ppi * spec.f / spec.fs;
+                g[lane] = spec.gDB * 0.05 * std::numbers::ln10;
+                q[lane] = spec.q;
+                lane += 1;
+                if (lane == batchLanes) {
+                    flush();
+                }
+            } else {
+                nums[i] = updateCoeff(spec.filterType, spec.f, spec.fs, spec.gDB, spec.q, spec.n, coeffs[i],
+                                       spec.useFastMath);
             }
-            return coeff;
         }
-    }
-
-    std::vector<coeff33> DesignFilter::getLowShelf(size_t n, double w0, double g, double q) {
-        if (n == 1) {
-            auto [a, b] = MartinCoeff::get1LowShelf(w0, g);
-            return {{{a[0], a[1], 0.0}, {b[0], b[1], 0.0}}};
-        } else {
-            auto qs = getQs(n, q);
-            auto _g = std::pow(g, 1.0 / static_cast<double>(qs.size()));
-            std::vector<coeff33> coeff;
-            coeff.reserve(qs.size());
-            for (auto _q: qs) {
-                coeff.push_back(MartinCoeff::get2LowShelf(w0, _g, _q));
-            }
-            return coeff;
+        if (lane > 0) {
+            flush();
         }
     }
 
-    std::vector<coeff33> DesignFilter::getHighShelf(size_t n, double w0, double g, double q) {
-        if (n == 1) {
-            auto [a, b] = MartinCoeff::get1HighShelf(w0, g);
-            return {{{a[0], a[1], 0.0}, {b[0], b[1], 0.0}}};
-        } else {
-            auto qs = getQs(n, q);
-            auto _g = std::pow(g, 1.0 / static_cast<double>(qs.size()));
-            std::vector<coeff33> coeff;
-            coeff.reserve(qs.size());
-            for (auto _q: qs) {
-                coeff.push_back(MartinCoeff::get2HighShelf(w0, _g, _q));
-            }
-            return coeff;
+    void DesignFilter::updatePeakBatch(const std::array<double, batchLanes> &w0,
+                                       const std::array<double, batchLanes> &g,
+                                       const std::array<double, batchLanes> &q,
+                                       std::array<coeff33, batchLanes> &coeffs) {
+        std::array<double, batchLanes> a1{}, a2{}, b0{}, b1{}, b2{};
+        for (size_t l = 0; l < batchLanes; ++l) {
+            // g holds the gain in nepers, i.e. gain = exp(g), and sqrt(gain) = exp(g / 2)
+            const auto sqrtGain = batchExp(0.5 * g[l]);
+            const auto gain = sqrtGain * sqrtGain;
+            // solve_a(w0, 0.5 / sqrt(gain) / q), cosh(x) = 0.5 * (exp(x) + exp(-x))
+            // r <= w0 <= pi when b <= 1, so cos(r) = 1 - 2 * sin(r / 2)^2 needs sin on [0, pi/2] only
+            const auto b = 0.5 / (sqrtGain * q[l]);
+            const auto d = 1 - b * b;
+            const auto r = std::sqrt(std::abs(d)) * w0[l];
+            const auto expR = batchExp(r);
+            const auto sinR = batchSin(std::min(0.5 * r, 0.5 * pi));
+            const auto c = d >= 0 ? 1 - 2 * sinR * sinR : 0.5 * (expR + 1 / expR);
+            const auto e = batchExp(-b * w0[l]);
+            const auto aa1 = -2 * e * c;
+            const auto aa2 = e * e;
+            // get_AB
+            const auto A0 = (1 + aa1 + aa2) * (1 + aa1 + aa2);
+            const auto A1 = (1 - aa1 + aa2) * (1 - aa1 + aa2);
+            const auto A2 = -4 * aa2;
+            // get_phi
+            const auto sinW = batchSin(std::min(0.5 * w0[l], 0.5 * pi));
+            const auto phi1 = sinW * sinW;
+            const auto phi0 = 1 - phi1;
+            const auto phi2 = 4 * phi0 * phi1;
+            const auto g2 = gain * gain;
+            const auto R1 = (A0 * phi0 + A1 * phi1 + A2 * phi2) * g2;
+            const auto R2 = (-A0 + A1 + 4 * (phi0 - phi1) * A2) * g2;
+            const auto B0 = A0;
+            const auto B2 = (R1 - R2 * phi1 - B0) / (4 * phi1 * phi1);
+            const auto B1 = R2 + B0 + 4 * (phi1 - phi0) * B2;
+            // get_ab
+            const auto sB0 = std::sqrt(std::max(B0, 0.0));
+            const auto sB1 = std::sqrt(std::max(B1, 0.0));
+            const auto W = 0.5 * (sB0 + sB1);
+            const auto bb0 = 0.5 * (W + std::sqrt(std::max(W * W + B2, 0.0)));
+            a1[l] = aa1;
+            a2[l] = aa2;
+            b0[l] = bb0;
+            b1[l] = 0.5 * (sB0 - sB1);
+            b2[l] = -B2 / 4 / bb0;
         }
-    }
-
-    std::vector<coeff33> DesignFilter::getBandPass(size_t n, double w0, double q) {
-        auto bw = 2 * std::asinh(0.5 / q) / std::log(2);
-        auto w = w0 / std::pow(2, bw / 2);
-        auto g = db_to_gain(-6 / static_cast<double>(n));
-        auto _q = std::sqrt(1 - g * g) * w * w0 / g / (w0 * w0 - w * w);
-
-        std::vector<coeff33> coeff;
-        coeff.reserve(n / 2);
-        _q = std::max(_q, 0.025);
-        auto singleCoeff = MartinCoeff::get2BandPass(w0, _q);
-        for (size_t i = 0; i < n / 2; ++i) {
-            coeff.push_back(singleCoeff);
-        }
-        return coeff;
-    }
-
-    std::vector<coeff33> DesignFilter::getNotch(size_t n, double w0, double q) {
-        auto bw = 2 * std::asinh(0.5 / q) / std::log(2);
-        auto w = w0 / std::pow(2, bw / 2);
-        auto g = db_to_gain(-6 / static_cast<double>(n));
-        auto _q = g * w * w0 / std::sqrt((1 - g * g)) / (w0 * w0 - w * w);
-
-        std::vector<coeff33> coeff;
-        coeff.reserve(n / 2);
-        auto singleCoeff = MartinCoeff::get2Notch(w0, _q);
-        for (size_t i = 0; i < n / 2; ++i) {
-            coeff.push_back(singleCoeff);
+        for (size_t l = 0; l < batchLanes; ++l) {
+            coeffs[l] = {{1.0, a1[l], a2[l]}, {b0[l], b1[l], b2[l]}};
         }
-        return coeff;
     }
 
-    std::vector<coeff33> DesignFilter::getPeak(double w0, double g, double q) {
-        return {MartinCoeff::get2Peak(w0, g, q)};
-    }
-
-    std::vector<coeff33> DesignFilter::getBandShelf(size_t n, double w0, double g, double q) {
-        if (n <= 2) {
-            return {};
-        }
-        auto bw = 2 * std::asinh(0.5 / q) / std::log(2);
-        auto w1 = w0 / std::pow(2, bw / 2);
-        auto w2 = w0 * std::pow(2, bw / 2);
-        std::vector<coeff33> coeff1;
-        if (w1 > 10.0 * 2 * pi / 48000) {
-            coeff1 = getLowShelf(n, w1, 1 / g, std::sqrt(2) / 2);
-        } else {
-            coeff1.push_back({{1, 1, 1}, {1, 1, 1}});
-        }
-        if (w2 < 22000.0 * 2 * pi / 48000) {
-            auto coeff2 = getLowShelf(n, w2, g, std::sqrt(2) / 2);
-            coeff1.insert(coeff1.end(), coeff2.begin(), coeff2.end());
-        } else {
-            coeff1.push_back({{1, 1, 1}, {g, g, g}});
-        }
-        return coeff1;
-    }
-
-    std::vector<double> DesignFilter::getQs(size_t n, double q0) {
+    size_t DesignFilter::updateQs(const size_t n, const double q0, std::array<double, maxSections> &qs) {
         const size_t number = n / 2;
-        const auto theta0 = pi / static_cast<double>(number) / 4;
         const auto scale = std::pow(std::sqrt(2.0) * q0, 1 / static_cast<double>(number));
         const auto rescale_base = std::log10(std::sqrt(2.0) * q0) / std::pow(static_cast<double>(n), 1.5) * 12;
-        std::vector<double> qs(number);
         for (size_t i = 0; i < number; i++) {
             const auto centered = static_cast<double>(i) - static_cast<double>(number) / 2 + 0.5;
             const auto rescale = centered * rescale_base;
-            const auto theta = theta0 * static_cast<double>(2 * i + 1);
-            qs[i] = 1.0 / 2.0 / std::cos(theta) * scale * std::pow(2, rescale);
+            qs[i] = butterworthQs[number][i] * scale * std::pow(2, rescale);
         }
-        return qs;
+        return number;
     }
 
+    template<typename Math, typename Coeff>
     size_t DesignFilter::updateLowPass(size_t n, double w0, double q, std::array<coeff33, 16> &coeffs,
                                        size_t startIdx) {
         if (n == 1) {
-            auto [a, b] = MartinCoeff::get1LowPass(w0);
+            auto [a, b] = Coeff::get1LowPass(w0);
             coeffs[0] = {{a[0], a[1], 0.0}, {b[0], b[1], 0.0}};
             return 1;
         }
-        const size_t number = n / 2;
-        const auto theta0 = pi / static_cast<double>(number) / 4;
-        const auto scale = std::pow(std::sqrt(2.0) * q, 1 / static_cast<double>(number));
-        const auto rescale_base = std::log10(std::sqrt(2.0) * q) / std::pow(static_cast<double>(n), 1.5) * 12;
+        std::array<double, maxSections> qs{};
+        const auto number = updateQs(n, q, qs);
         for (size_t i = 0; i < number; i++) {
-            const auto centered = static_cast<double>(i) - static_cast<double>(number) / 2 + 0.5;
-            const auto rescale = centered * rescale_base;
-            const auto theta = theta0 * static_cast<double>(2 * i + 1);
-            const auto qs = 1.0 / 2.0 / std::cos(theta) * scale * std::pow(2, rescale);
-            coeffs[i + startIdx] = MartinCoeff::get2LowPass(w0, qs);
+            coeffs[i + startIdx] = Coeff::get2LowPass(w0, qs[i]);
         }
         return number;
     }
 
+    template<typename Math, typename Coeff>
     size_t DesignFilter::updateHighPass(size_t n, double w0, double q, std::array<coeff33, 16> &coeffs,
                                         size_t startIdx) {
         if (n == 1) {
-            auto [a, b] = MartinCoeff::get1HighPass(w0);
+            auto [a, b] = Coeff::get1HighPass(w0);
             coeffs[0] = {{a[0], a[1], 0.0}, {b[0], b[1], 0.0}};
             return 1;
         }
-        const size_t number = n / 2;
-        const auto theta0 = pi / static_cast<double>(number) / 4;
-        const auto scale = std::pow(std::sqrt(2.0) * q, 1 / static_cast<double>(number));
-        const auto rescale_base = std::log10(std::sqrt(2.0) * q) / std::pow(static_cast<double>(n), 1.5) * 12;
+        std::array<double, maxSections> qs{};
+        const auto number = updateQs(n, q, qs);
         for (size_t i = 0; i < number; i++) {
-            const auto centered = static_cast<double>(i) - static_cast<double>(number) / 2 + 0.5;
-            const auto rescale = centered * rescale_base;
-            const auto theta = theta0 * static_cast<double>(2 * i + 1);
-            const auto qs = 1.0 / 2.0 / std::cos(theta) * scale * std::pow(2, rescale);
-            coeffs[i + startIdx] = MartinCoeff::get2HighPass(w0, qs);
+            coeffs[i + startIdx] = Coeff::get2HighPass(w0, qs[i]);
         }
         return number;
     }
 
+    template<typename Math, typename Coeff>
     size_t DesignFilter::updateTiltShelf(size_t n, double w0, double g, double q, std::array<coeff33, 16> &coeffs,
                                          size_t startIdx) {
         if (n == 1) {
-            auto [a, b] = MartinCoeff::get1TiltShelf(w0, g);
+            auto [a, b] = Coeff::get1TiltShelf(w0, g);
             coeffs[0] = {{a[0], a[1], 0.0}, {b[0], b[1], 0.0}};
             return 1;
         }
-        const size_t number = n / 2;
-        const auto _g = std::pow(g, 1.0 / static_cast<double>(number));
-        const auto theta0 = pi / static_cast<double>(number) / 4;
-        const auto scale = std::pow(std::sqrt(2.0) * q, 1 / static_cast<double>(number));
-        const auto rescale_base = std::log10(std::sqrt(2.0) * q) / std::pow(static_cast<double>(n), 1.5) * 12;
+        std::array<double, maxSections> qs{};
+        const auto number = updateQs(n, q, qs);
+        const auto _g = Math::pow(g, 1.0 / static_cast<double>(number));
         for (size_t i = 0; i < number; i++) {
-            const auto centered = static_cast<double>(i) - static_cast<double>(number) / 2 + 0.5;
-            const auto rescale = centered * rescale_base;
-            const auto theta = theta0 * static_cast<double>(2 * i + 1);
-            const auto _q = 1.0 / 2.0 / std::cos(theta) * scale * std::pow(2, rescale);
-            coeffs[i + startIdx] = MartinCoeff::get2TiltShelf(w0, _g, _q);
+            coeffs[i + startIdx] = Coeff::get2TiltShelf(w0, _g, qs[i]);
         }
         return number;
     }
 
+    template<typename Math, typename Coeff>
     size_t DesignFilter::updateLowShelf(size_t n, double w0, double g, double q, std::array<coeff33, 16> &coeffs,
                                          size_t startIdx) {
         if (n == 1) {
-            auto [a, b] = MartinCoeff::get1LowShelf(w0, g);
+            auto [a, b] = Coeff::get1LowShelf(w0, g);
             coeffs[0] = {{a[0], a[1], 0.0}, {b[0], b[1], 0.0}};
             return 1;
         }
-        const size_t number = n / 2;
-        const auto _g = std::pow(g, 1.0 / static_cast<double>(number));
-        const auto theta0 = pi / static_cast<double>(number) / 4;
-        const auto scale = std::pow(std::sqrt(2.0) * q, 1 / static_cast<double>(number));
-        const auto rescale_base = std::log10(std::sqrt(2.0) * q) / std::pow(static_cast<double>(n), 1.5) * 12;
+        std::array<double, maxSections> qs{};
+        const auto number = updateQs(n, q, qs);
+        const auto _g = Math::pow(g, 1.0 / static_cast<double>(number));
         for (size_t i = 0; i < number; i++) {
-            const auto centered = static_cast<double>(i) - static_cast<double>(number) / 2 + 0.5;
-            const auto rescale = centered * rescale_base;
-            const auto theta = theta0 * static_cast<double>(2 * i + 1);
-            const auto _q = 1.0 / 2.0 / std::cos(theta) * scale * std::pow(2, rescale);
-            coeffs[i + startIdx] = MartinCoeff::get2LowShelf(w0, _g, _q);
+            coeffs[i + startIdx] = Coeff::get2LowShelf(w0, _g, qs[i]);
         }
         return number;
     }
 
+    template<typename Math, typename Coeff>
     size_t DesignFilter::updateHighShelf(size_t n, double w0, double g, double q, std::array<coeff33, 16> &coeffs,
                                          size_t startIdx) {
         if (n == 1) {
-            auto [a, b] = MartinCoeff::get1HighShelf(w0, g);
+            auto [a, b] = Coeff::get1HighShelf(w0, g);
             coeffs[0] = {{a[0], a[1], 0.0}, {b[0], b[1], 0.0}};
             return 1;
         }
-        const size_t number = n / 2;
-        const auto _g = std::pow(g, 1.0 / static_cast<double>(number));
-        const auto theta0 = pi / static_cast<double>(number) / 4;
-        const auto scale = std::pow(std::sqrt(2.0) * q, 1 / static_cast<double>(number));
-        const auto rescale_base = std::log10(std::sqrt(2.0) * q) / std::pow(static_cast<double>(n), 1.5) * 12;
+        std::array<double, maxSections> qs{};
+        const auto number = updateQs(n, q, qs);
+        const auto _g = Math::pow(g, 1.0 / static_cast<double>(number));
         for (size_t i = 0; i < number; i++) {
-            const auto centered = static_cast<double>(i) - static_cast<double>(number) / 2 + 0.5;
-            const auto rescale = centered * rescale_base;
-            const auto theta = theta0 * static_cast<double>(2 * i + 1);
-            const auto _q = 1.0 / 2.0 / std::cos(theta) * scale * std::pow(2, rescale);
-            coeffs[i + startIdx] = MartinCoeff::get2HighShelf(w0, _g, _q);
+            coeffs[i + startIdx] = Coeff::get2HighShelf(w0, _g, qs[i]);
         }
         return number;
     }
 
+    template<typename Math, typename Coeff>
     size_t DesignFilter::updateBandPass(size_t n, double w0, double q, std::array<coeff33, 16> &coeffs, size_t startIdx) {
-        auto halfbw = std::asinh(0.5 / q) / std::log(2);
-        auto w = w0 / std::pow(2, halfbw);
-        auto g = db_to_gain(-6 / static_cast<double>(n));
+        auto halfbw = Math::asinh(0.5 / q) / std::log(2);
+        auto w = w0 / Math::pow(2.0, halfbw);
+        auto g = Math::dbToGain(-6 / static_cast<double>(n));
         auto _q = std::sqrt(1 - g * g) * w * w0 / g / (w0 * w0 - w * w);
 
         _q = std::max(_q, 0.025);
-        const auto singleCoeff = MartinCoeff::get2BandPass(w0, _q);
+        const auto singleCoeff = Coeff::get2BandPass(w0, _q);
         for (size_t i = 0; i < n / 2; ++i) {
             coeffs[i + startIdx] = singleCoeff;
         }
         return n / 2;
     }
 
+    template<typename Math, typename Coeff>
     size_t DesignFilter::updateNotch(size_t n, double w0, double q, std::array<coeff33, 16> &coeffs, size_t startIdx) {
-        auto halfbw = std::asinh(0.5 / q) / std::log(2);
-        auto w = w0 / std::pow(2, halfbw);
-        auto g = db_to_gain(-6 / static_cast<double>(n));
+        auto halfbw = Math::asinh(0.5 / q) / std::log(2);
+        auto w = w0 / Math::pow(2.0, halfbw);
+        auto g = Math::dbToGain(-6 / static_cast<double>(n));
         auto _q = g * w * w0 / std::sqrt((1 - g * g)) / (w0 * w0 - w * w);
 
-        const auto singleCoeff = MartinCoeff::get2Notch(w0, _q);
+        const auto singleCoeff = Coeff::get2Notch(w0, _q);
         for (size_t i = 0; i < n / 2; ++i) {
             coeffs[i + startIdx] = singleCoeff;
         }
         return n / 2;
     }
 
+    template<typename Math, typename Coeff>
     size_t DesignFilter::updatePeak(double w0, double g, double q, std::array<coeff33, 16> &coeffs) {
-        coeffs[0] = MartinCoeff::get2Peak(w0, g, q);
+        coeffs[0] = Coeff::get2Peak(w0, g, q);
         return 1;
     }
 
+    template<typename Math, typename Coeff>
     size_t DesignFilter::updateBandShelf(size_t n, double w0, double g, double q, std::array<coeff33, 16> &coeffs, size_t startIdx ) {
         if (n <= 2) {
             return 0;
         }
-        const auto halfbw = std::asinh(0.5 / q) / std::log(2);
-        const auto scale = std::pow(2, halfbw);
+        const auto halfbw = Math::asinh(0.5 / q) / std::log(2);
+        const auto scale = Math::pow(2.0, halfbw);
         const auto w1 = w0 / scale;
         const auto w2 = w0 * scale;
         const auto f1 = w1 > 10.0 * 2 * pi / 48000, f2 = w2 < 22000.0 * 2 * pi / 48000;
         size_t n1 = 1;
         size_t n2 = 0;
         if (f1 && f2) {
-            n1 = updateLowShelf(n, w1, 1 / g, std::sqrt(2) / 2, coeffs, startIdx);
-            n2 = updateLowShelf(n, w2, g, std::sqrt(2) / 2, coeffs, startIdx + n1);
+            n1 = updateLowShelf<Math, Coeff>(n, w1, 1 / g, std::sqrt(2) / 2, coeffs, startIdx);
+            n2 = updateLowShelf<Math, Coeff>(n, w2, g, std::sqrt(2) / 2, coeffs, startIdx + n1);
         } else if (f1) {
-            n1 = updateHighShelf(n, w1, g, std::sqrt(2) / 2, coeffs, startIdx);
+            n1 = updateHighShelf<Math, Coeff>(n, w1, g, std::sqrt(2) / 2, coeffs, startIdx);
         } else if (f2) {
-            n1 = updateLowShelf(n, w2, g, std::sqrt(2) / 2, coeffs, startIdx);
+            n1 = updateLowShelf<Math, Coeff>(n, w2, g, std::sqrt(2) / 2, coeffs, startIdx);
         } else {
             coeffs[startIdx] = {{1, 1, 1}, {g, g, g}};
         }
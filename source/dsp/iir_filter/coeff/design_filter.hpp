@@ -18,72 +18,127 @@
 #include "martin_coeff.hpp"
 
 namespace zlIIR {
+    /**
+     * the parameters of a filter design
+     */
+    struct DesignSpec {
+        FilterType filterType{peak};
+        double f{1000}, fs{48000}, gDB{0}, q{0.707};
+        size_t n{2};
+        bool useFastMath{false};
+    };
+
+    /**
+     * designs the 2nd order sections of filters into fixed-size arrays, it never allocates
+     */
     class DesignFilter {
     public:
+        /** the maximum number of 2nd order sections of a single filter (order 16) */
+        static constexpr size_t maxSections = 8;
+
         /**
-         * get a vector of 2nd order filter coeffs
+         * update an array of 2nd order filter coeffs
          * @param filterType filter type
          * @param f frequency
          * @param fs sample rate
          * @param gDB gain
          * @param q Q
          * @param n filter order
-         * @return a vector of 2nd order filter coeffs
+         * @param coeffs the array of coeffs
+         * @param useFastMath whether to use the approximated transcendental functions (see FastMath)
+         * @return the actual filter size
+         */
+        static size_t updateCoeff(FilterType filterType,
+                                  double f, double fs, double gDB, double q, size_t n, std::array<coeff33, 16> &coeffs,
+                                  bool useFastMath = false);
+
+        /** the number of filters designed together in the vectorized pass */
+        static constexpr size_t batchLanes = 4;
+
+        /**
+         * update the arrays of 2nd order filter coeffs of many filters at once
+         * 2nd order peaks (the default band) are designed batchLanes at a time, one filter per lane, with branch-free
+         * minimax exp/sin kernels, the other filters are designed one by one
+         * the kernels are accurate to the last bits, so the batched peaks are as accurate as the exact design
+         * @param specs the parameters of filters
+         * @param num the number of filters
+         * @param coeffs the arrays of coeffs, one for each filter
+         * @param nums the actual filter sizes, one for each filter
          */
-        static std::vector<coeff33> getCoeff(FilterType filterType,
-                                             double f, double fs, double gDB, double q, size_t n);
+        static void updateCoeffBatch(const DesignSpec *specs, size_t num,
+                                     std::array<coeff33, 16> *coeffs, size_t *nums);
 
         /**
-         * update an array of 2nd order filter coeffs
+         * update an array of the analog prototypes of the 2nd order filter coeffs (see AnalogFunc)
+         * the prototypes are split into sections in the same way as updateCoeff
          * @param filterType filter type
          * @param f frequency
          * @param fs sample rate
          * @param gDB gain
          * @param q Q
          * @param n filter order
-         * @param coeffs the array of coeffs
+         * @param coeffs the array of coeffs, polynomials in ascending powers of s
          * @return the actual filter size
          */
-        static size_t updateCoeff(FilterType filterType,
-                                  double f, double fs, double gDB, double q, size_t n, std::array<coeff33, 16> &coeffs);
+        static size_t updateAnalogCoeff(FilterType filterType,
+                                        double f, double fs, double gDB, double q, size_t n,
+                                        std::array<coeff33, 16> &coeffs);
 
     private:
-        static std::vector<coeff33> getLowPass(size_t n, double w0, double q);
-
-        static std::vector<coeff33> getHighPass(size_t n, double w0, double q);
-
-        static std::vector<coeff33> getTiltShelf(size_t n, double w0, double g, double q);
-
-        static std::vector<coeff33> getLowShelf(size_t n, double w0, double g, double q);
-
-        static std::vector<coeff33> getHighShelf(size_t n, double w0, double g, double q);
-
-        static std::vector<coeff33> getBandPass(size_t n, double w0, double q);
-
-        static std::vector<coeff33> getNotch(size_t n, double w0, double q);
-
-        static std::vector<coeff33> getPeak(double w0, double g, double q);
-
-        static std::vector<coeff33> getBandShelf(size_t n, double w0, double g, double q);
+        /**
+         * @tparam Math the transcendental functions, ExactMath or FastMath
+         * @tparam Coeff the section designer, MartinCoeff<Math> or AnalogFunc
+         */
+        template<typename Math, typename Coeff>
+        static size_t designCoeff(FilterType filterType,
+                                  double f, double fs, double gDB, double q, size_t n, std::array<coeff33, 16> &coeffs);
 
-        static std::vector<double> getQs(size_t n, double q0);
+        /**
+         * update the Q values of the 2nd order sections of a filter, starting from the Butterworth Qs
+         * @param n filter order
+         * @param q0 Q
+         * @param qs the array of Qs
+         * @return the number of 2nd order sections
+         */
+        static size_t updateQs(size_t n, double q0, std::array<double, maxSections> &qs);
 
+        template<typename Math, typename Coeff>
         static size_t updateLowPass(size_t n, double w0, double q, std::array<coeff33, 16> &coeffs, size_t startIdx);
 
+        template<typename Math, typename Coeff>
         static size_t updateHighPass(size_t n, double w0, double q, std::array<coeff33, 16> &coeffs, size_t startIdx);
 
+        template<typename Math, typename Coeff>
         static size_t updateTiltShelf(size_t n, double w0, double g, double q, std::array<coeff33, 16> &coeffs, size_t startIdx);
 
+        template<typename Math, typename Coeff>
         static size_t updateLowShelf(size_t n, double w0, double g, double q, std::array<coeff33, 16> &coeffs, size_t startIdx);
 
+        template<typename Math, typename Coeff>
         static size_t updateHighShelf(size_t n, double w0, double g, double q, std::array<coeff33, 16> &coeffs, size_t startIdx);
 
+        template<typename Math, typename Coeff>
         static size_t updateBandPass(size_t n, double w0, double q, std::array<coeff33, 16> &coeffs, size_t startIdx);
 
+        template<typename Math, typename Coeff>
         static size_t updateNotch(size_t n, double w0, double q, std::array<coeff33, 16> &coeffs, size_t startIdx);
 
+        template<typename Math, typename Coeff>
         static size_t updatePeak(double w0, double g, double q, std::array<coeff33, 16> &coeffs);
 
+        /**
+         * design batchLanes 2nd order peaks, it performs the same steps as MartinCoeff<ExactMath>::get2Peak
+         * @param w0 the normalized angular frequencies
+         * @param g the gains in nepers
+         * @param q the Qs
+         * @param coeffs the coeffs, one for each lane
+         */
+        static void updatePeakBatch(const std::array<double, batchLanes> &w0,
+                                    const std::array<double, batchLanes> &g,
+                                    const std::array<double, batchLanes> &q,
+                                    std::array<coeff33, batchLanes> &coeffs);
+
+        template<typename Math, typename Coeff>
         static size_t updateBandShelf(size_t n, double w0, double g, double q, std::array<coeff33, 16> &coeffs, size_t startIdx);
 
     };
@@ -0,0 +1,146 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_FAST_MATH_HPP
+#define ZLEQUALIZER_FAST_MATH_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+namespace zlIIR {
+    /**
+     * the transcendental functions of the coefficient design, forwarded to the standard library
+     */
+    struct ExactMath {
+        static double exp(const double x) { return std::exp(x); }
+
+        static double log(const double x) { return std::log(x); }
+
+        static double pow(const double x, const double y) { return std::pow(x, y); }
+
+        static double sin(const double x) { return std::sin(x); }
+
+        static double cos(const double x) { return std::cos(x); }
+
+        static double cosh(const double x) { return std::cosh(x); }
+
+        static double asinh(const double x) { return std::asinh(x); }
+
+        static double dbToGain(const double db) { return std::pow(10, db * 0.05); }
+
+        /**
+         * exp(2x), given ex = exp(x)
+         */
+        static double exp2x(const double x, const double) { return std::exp(2 * x); }
+    };
+
+    /**
+     * inlined low-degree polynomial approximations of the transcendental functions of the coefficient design
+     * they skip the special cases (inf, nan, denormals, errno) and the last-bit rounding of the standard library
+     * the arguments are assumed to be finite, log/pow/asinh require x > 0 (x >= 0 for asinh)
+     * after the range reduction the truncation error grows with the reduced argument, so the error is tiny for
+     * the small arguments where the matched design is ill-conditioned (low w0), and it is largest at high w0:
+     * relative errors: exp < 3e-10, pow < 3e-10 + 1e-9 * |y|; absolute errors: log < 1e-9, sin/cos < 2e-9
+     */
+    struct FastMath {
+        static double exp(double x) {
+            x = std::clamp(x, -700.0, 700.0);
+            const auto k = round(x * std::numbers::log2e);
+            // |r| <= ln2 / 2
+            const auto r = x - static_cast<double>(k) * std::numbers::ln2;
+            // the Taylor polynomial of degree 8, in the Estrin scheme to shorten the dependency chain
+            const auto r2 = r * r, r4 = r2 * r2;
+            const auto p01 = 1.0 + r, p23 = 0.5 + r * (1.0 / 6.0);
+            const auto p45 = 1.0 / 24.0 + r * (1.0 / 120.0), p67 = 1.0 / 720.0 + r * (1.0 / 5040.0);
+            const auto p = (p01 + r2 * p23) + r4 * ((p45 + r2 * p67) + r4 * (1.0 / 40320.0));
+            return p * std::bit_cast<double>(static_cast<std::uint64_t>(k + 1023) << 52);
+        }
+
+        static double log(const double x) {
+            const auto bits = std::bit_cast<std::uint64_t>(x);
+            auto e = static_cast<double>(static_cast<int>(bits >> 52) - 1023);
+            // the mantissa in [1, 2)
+            auto m = std::bit_cast<double>((bits & 0x000fffffffffffffull) | 0x3ff0000000000000ull);
+            if (m > std::numbers::sqrt2) {
+                m *= 0.5;
+                e += 1.0;
+            }
+            // log(m) = 2 * atanh(s), |s| <= 0.172
+            const auto s = (m - 1) / (m + 1);
+            const auto s2 = s * s, s4 = s2 * s2;
+            const auto p = (1.0 + s2 * (1.0 / 3.0)) + s4 * ((1.0 / 5.0 + s2 * (1.0 / 7.0)) + s4 * (1.0 / 9.0));
+            return e * std::numbers::ln2 + 2 * s * p;
+        }
+
+        static double pow(const double x, const double y) { return exp(y * log(x)); }
+
+        static double sin(const double x) {
+            double r;
+            const auto quadrant = reduce(x, r);
+            return sinCos(r, quadrant);
+        }
+
+        static double cos(const double x) {
+            double r;
+            const auto quadrant = reduce(x, r);
+            return sinCos(r, quadrant + 1);
+        }
+
+        static double cosh(const double x) {
+            const auto e = exp(x);
+            return 0.5 * (e + 1 / e);
+        }
+
+        static double asinh(const double x) { return log(x + std::sqrt(x * x + 1)); }
+
+        static double dbToGain(const double db) { return exp(db * (0.05 * std::numbers::ln10)); }
+
+        /**
+         * exp(2x), given ex = exp(x)
+         */
+        static double exp2x(const double, const double ex) { return ex * ex; }
+
+    private:
+        /**
+         * round to the nearest integer, it compiles to a single conversion when errno is not set (e.g. -Ofast)
+         */
+        static std::int64_t round(const double x) {
+            return std::llrint(x);
+        }
+
+        /**
+         * reduce x to r in [-pi/4, pi/4], x = r + k * pi/2
+         * @return k mod 4
+         */
+        static unsigned reduce(const double x, double &r) {
+            const auto k = round(x * (2 / std::numbers::pi));
+            r = x - static_cast<double>(k) * (0.5 * std::numbers::pi);
+            return static_cast<unsigned>(k) & 3u;
+        }
+
+        /**
+         * sin(r + quadrant * pi/2) for r in [-pi/4, pi/4]
+         * both polynomials are evaluated and selected, so that the result does not depend on a branch
+         */
+        static double sinCos(const double r, const unsigned quadrant) {
+            const auto r2 = r * r, r4 = r2 * r2;
+            const auto s = r + r * r2 * ((-1.0 / 6.0 + r2 * (1.0 / 120.0)) +
+                                         r4 * (-1.0 / 5040.0 + r2 * (1.0 / 362880.0)));
+            const auto c = 1 + r2 * ((-0.5 + r2 * (1.0 / 24.0)) +
+                                     r4 * ((-1.0 / 720.0 + r2 * (1.0 / 40320.0)) - r4 * (1.0 / 3628800.0)));
+            const auto v = (quadrant & 1u) ? c : s;
+            return (quadrant & 2u) ? -v : v;
+        }
+    };
+}
+
+#endif //ZLEQUALIZER_FAST_MATH_HPP
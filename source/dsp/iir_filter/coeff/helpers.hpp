@@ -18,7 +18,6 @@
 #include <array>
 #include <numbers>
 #include <numeric>
-#include <vector>
 #include <tuple>
 
 namespace zlIIR {
@@ -18,14 +18,15 @@ const static double pi = std::numbers::pi;
 const static double pi2 = std::numbers::pi * std::numbers::pi;
 
 namespace zlIIR {
-    coeff22 MartinCoeff::get1LowPass(double w0) {
+    template<typename Math>
+    coeff22 MartinCoeff<Math>::get1LowPass(double w0) {
         coeff2 a{}, b{};
         auto fc = w0 / pi;
         auto fm = 0.5 * std::sqrt(fc * fc + 1);
-        auto phim = 1 - std::cos(pi * fm);
+        auto phim = 1 - Math::cos(pi * fm);
 
         a[0] = 1;
-        a[1] = -std::exp(-w0);
+        a[1] = -Math::exp(-w0);
 
         auto alpha = -2 * a[1] / std::pow(1 + a[1], 2);
         auto k = (fc * fc) / (fc * fc + fm * fm);
@@ -37,13 +38,14 @@ namespace zlIIR {
         return {a, b};
     }
 
-    coeff22 MartinCoeff::get1HighPass(double w0) {
+    template<typename Math>
+    coeff22 MartinCoeff<Math>::get1HighPass(double w0) {
         coeff2 a{}, b{};
         auto wm = w0 * 0.5;
-        coeff2 phim = {1 - std::pow(std::sin(wm / 2), 2), std::pow(std::sin(wm / 2), 2)};
+        coeff2 phim = {1 - std::pow(Math::sin(wm / 2), 2), std::pow(Math::sin(wm / 2), 2)};
 
         a[0] = 1;
-        a[1] = -std::exp(-w0);
+        a[1] = -Math::exp(-w0);
 
         coeff2 A = {std::pow(a[0] + a[1], 2), std::pow(a[0] - a[1], 2)};
         auto B1 = (wm * wm) / (wm * wm + w0 * w0) * (A[0] * phim[0] + A[1] * phim[1]) / phim[1];
@@ -54,11 +56,12 @@ namespace zlIIR {
         return {a, b};
     }
 
-    coeff22 MartinCoeff::get1TiltShelf(double w0, double g) {
+    template<typename Math>
+    coeff22 MartinCoeff<Math>::get1TiltShelf(double w0, double g) {
         coeff2 a{}, b{};
         auto fc = w0 / pi;
         auto fm = fc * 0.75;
-        auto phim = 1 - std::cos(pi * fm);
+        auto phim = 1 - Math::cos(pi * fm);
         auto alpha = 2 / pi2 * (1 / std::pow(fm, 2) + 1 / g / std::pow(fc, 2)) - 1 / phim;
         auto beta = 2 / pi2 * (1 / std::pow(fm, 2) + g / std::pow(fc, 2)) - 1 / phim;
 
@@ -72,21 +75,24 @@ namespace zlIIR {
         return {a, b};
     }
 
-    coeff22 MartinCoeff::get1LowShelf(double w0, double g) {
+    template<typename Math>
+    coeff22 MartinCoeff<Math>::get1LowShelf(double w0, double g) {
         auto [a, b] = get1TiltShelf(w0, 1.0 / g);
 
         auto A = std::sqrt(g);
         return {a, {b[0] * A, b[1] * A}};
     }
 
-    coeff22 MartinCoeff::get1HighShelf(double w0, double g) {
+    template<typename Math>
+    coeff22 MartinCoeff<Math>::get1HighShelf(double w0, double g) {
         auto [a, b] = get1TiltShelf(w0, g);
 
         auto A = std::sqrt(g);
         return {a, {b[0] * A, b[1] * A}};
     }
 
-    coeff33 MartinCoeff::get2LowPass(double w0, double q) {
+    template<typename Math>
+    coeff33 MartinCoeff<Math>::get2LowPass(double w0, double q) {
         auto a = solve_a(w0, 0.5 / q, 1);
         auto A = get_AB(a);
         coeff3 ws{};
@@ -106,7 +112,8 @@ namespace zlIIR {
         return {a, b};
     }
 
-    coeff33 MartinCoeff::get2HighPass(double w0, double q) {
+    template<typename Math>
+    coeff33 MartinCoeff<Math>::get2HighPass(double w0, double q) {
         auto a = solve_a(w0, 0.5 / q, 1);
         auto A = get_AB(a);
         auto phi0 = get_phi(w0);
@@ -118,7 +125,8 @@ namespace zlIIR {
         return {a, b};
     }
 
-    coeff33 MartinCoeff::get2BandPass(double w0, double q) {
+    template<typename Math>
+    coeff33 MartinCoeff<Math>::get2BandPass(double w0, double q) {
         auto a = solve_a(w0, 0.5 / q);
         auto A = get_AB(a);
 
@@ -167,10 +175,11 @@ namespace zlIIR {
         }
     }
 
-    coeff33 MartinCoeff::get2Notch(double w0, double q) {
+    template<typename Math>
+    coeff33 MartinCoeff<Math>::get2Notch(double w0, double q) {
         coeff3 b{};
         if (w0 < pi) {
-            b = {1, -2 * std::cos(w0), 1};
+            b = {1, -2 * Math::cos(w0), 1};
         } else {
             b = {1, -2 * std::sinh(w0), 1};
         }
@@ -191,7 +200,8 @@ namespace zlIIR {
         return {a, b};
     }
 
-    coeff33 MartinCoeff::get2Peak(double w0, double g, double q) {
+    template<typename Math>
+    coeff33 MartinCoeff<Math>::get2Peak(double w0, double g, double q) {
         auto a = solve_a(w0, 0.5 / std::sqrt(g) / q);
         auto A = get_AB(a);
         auto phi0 = get_phi(w0);
@@ -207,7 +217,8 @@ namespace zlIIR {
         return {a, b};
     }
 
-    coeff33 MartinCoeff::get2TiltShelf(double w0, double g, double q) {
+    template<typename Math>
+    coeff33 MartinCoeff<Math>::get2TiltShelf(double w0, double g, double q) {
         bool reverse_ab = (g > 1);
         if (g > 1) {
             g = 1 / g;
@@ -221,7 +232,7 @@ namespace zlIIR {
         auto c1 = -2 * (1 + g) * std::pow(q * w0, 2);
         auto delta = c1 * c1 - 4 * c0 * c2;
         coeff3 ws{};
-        if (delta <= 0) {
+        if (delta <= 0 || c2 == 0) {
             ws = {0, w0 / 2, w0};
         } else {
             delta = std::sqrt(delta);
@@ -272,33 +283,38 @@ namespace zlIIR {
         }
     }
 
-    coeff33 MartinCoeff::get2LowShelf(double w0, double g, double q) {
+    template<typename Math>
+    coeff33 MartinCoeff<Math>::get2LowShelf(double w0, double g, double q) {
         auto [a, b] = get2TiltShelf(w0, 1 / g, q);
 
         auto A = std::sqrt(g);
         return {a, {b[0] * A, b[1] * A, b[2] * A}};
     }
 
-    coeff33 MartinCoeff::get2HighShelf(double w0, double g, double q) {
+    template<typename Math>
+    coeff33 MartinCoeff<Math>::get2HighShelf(double w0, double g, double q) {
         auto [a, b] = get2TiltShelf(w0, g, q);
 
         auto A = std::sqrt(g);
         return {a, {b[0] * A, b[1] * A, b[2] * A}};
     }
 
-    coeff3 MartinCoeff::solve_a(double w0, double b, double c) {
+    template<typename Math>
+    coeff3 MartinCoeff<Math>::solve_a(double w0, double b, double c) {
         coeff3 a{};
         a[0] = 1.0;
+        const auto e = Math::exp(-b * w0);
         if (b <= c) {
-            a[1] = -2 * std::exp(-b * w0) * std::cos(std::sqrt(c * c - b * b) * w0);
+            a[1] = -2 * e * Math::cos(std::sqrt(c * c - b * b) * w0);
         } else {
-            a[1] = -2 * std::exp(-b * w0) * std::cosh(std::sqrt(b * b - c * c) * w0);
+            a[1] = -2 * e * Math::cosh(std::sqrt(b * b - c * c) * w0);
         }
-        a[2] = std::exp(-2 * b * w0);
+        a[2] = Math::exp2x(-b * w0, e);
         return a;
     }
 
-    coeff3 MartinCoeff::get_AB(coeff3 a) {
+    template<typename Math>
+    coeff3 MartinCoeff<Math>::get_AB(coeff3 a) {
         coeff3 A{};
         A[0] = std::pow(a[0] + a[1] + a[2], 2);
         A[1] = std::pow(a[0] - a[1] + a[2], 2);
@@ -306,11 +322,13 @@ namespace zlIIR {
         return A;
     }
 
-    bool MartinCoeff::check_AB(zlIIR::coeff3 A) {
+    template<typename Math>
+    bool MartinCoeff<Math>::check_AB(coeff3 A) {
         return A[0] > 0 && A[1] > 0 && std::pow(0.5 * (std::sqrt(A[0]) + std::sqrt(A[1])), 2) + A[2] > 0;
     }
 
-    coeff3 MartinCoeff::get_ab(coeff3 A) {
+    template<typename Math>
+    coeff3 MartinCoeff<Math>::get_ab(coeff3 A) {
         coeff3 a{};
         A[0] = std::sqrt(std::max(A[0], 0.0));
         A[1] = std::sqrt(std::max(A[1], 0.0));
@@ -322,15 +340,17 @@ namespace zlIIR {
         return a;
     }
 
-    coeff3 MartinCoeff::get_phi(double w) {
+    template<typename Math>
+    coeff3 MartinCoeff<Math>::get_phi(double w) {
         coeff3 phi{};
-        phi[0] = 1 - std::pow(std::sin(w / 2), 2);
+        phi[0] = 1 - std::pow(Math::sin(w / 2), 2);
         phi[1] = 1 - phi[0];
         phi[2] = 4 * phi[0] * phi[1];
         return phi;
     }
 
-    coeff3 MartinCoeff::linear_solve(std::array<coeff3, 3> A, coeff3 b) {
+    template<typename Math>
+    coeff3 MartinCoeff<Math>::linear_solve(std::array<coeff3, 3> A, coeff3 b) {
         coeff3 x{};
         if (std::abs(A[0][0]) > std::abs(A[0][1])) {
             x[0] = b[0] / A[0][0];
@@ -349,4 +369,10 @@ namespace zlIIR {
         }
         return x;
     }
-}
\ No newline at end of file
+
+    template
+    class MartinCoeff<ExactMath>;
+
+    template
+    class MartinCoeff<FastMath>;
+}
@@ -12,8 +12,14 @@
 
 #include "helpers.hpp"
 #include "analog_func.hpp"
+#include "fast_math.hpp"
 
 namespace zlIIR {
+    /**
+     * matched 1st/2nd order coefficients
+     * @tparam Math the transcendental functions, ExactMath or FastMath
+     */
+    template<typename Math = ExactMath>
     class MartinCoeff {
     public:
         static coeff22 get1LowPass(double w0);
@@ -0,0 +1,90 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_COEFF_SNAPSHOT_HPP
+#define ZLEQUALIZER_COEFF_SNAPSHOT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include "coeff/helpers.hpp"
+
+namespace zlIIR {
+    /**
+     * a lock free, triple-buffered and version-stamped snapshot of the coefficients of a filter
+     * it is published by one (realtime) thread and read by one (non-realtime) thread
+     * the writer fills its back buffer with the used sections only and publishes it by swapping an index,
+     * the reader swaps the latest published buffer into its front only if there is a new one,
+     * hence neither side copies the whole array or waits for the other
+     */
+    class CoeffSnapshot {
+    public:
+        struct Snapshot {
+            std::array<coeff33, 16> coeffs{};
+            size_t num{0};
+            size_t version{0};
+        };
+
+        /**
+         * publish the first num sections of coeffs, call it on the writer thread
+         * @param coeffs
+         * @param num
+         */
+        void publish(const std::array<coeff33, 16> &coeffs, const size_t num) {
+            auto &back = buffers[backIdx].snapshot;
+            std::copy_n(coeffs.begin(), num, back.coeffs.begin());
+            back.num = num;
+            back.version = ++writerVersion;
+            backIdx = middle.exchange(static_cast<uint8_t>(backIdx | dirtyBit), std::memory_order_acq_rel) & indexMask;
+            version.store(writerVersion, std::memory_order_release);
+        }
+
+        /**
+         * take the latest published snapshot as the front, call it on the reader thread
+         * @return whether there is a new snapshot
+         */
+        bool acquire() {
+            if ((middle.load(std::memory_order_relaxed) & dirtyBit) == 0) { return false; }
+            frontIdx = middle.exchange(frontIdx, std::memory_order_acq_rel) & indexMask;
+            return true;
+        }
+
+        /**
+         * get the front snapshot, call it on the reader thread, it stays valid until the next acquire
+         * @return
+         */
+        const Snapshot &getFront() const { return buffers[frontIdx].snapshot; }
+
+        /**
+         * get the version of the latest published snapshot, it can be called on any thread
+         * @return
+         */
+        size_t getVersion() const { return version.load(std::memory_order_acquire); }
+
+    private:
+        static constexpr uint8_t dirtyBit = 4, indexMask = 3;
+
+        /** each buffer on its own cache lines, so that the two threads do not share them */
+        struct alignas(64) Buffer {
+            Snapshot snapshot;
+        };
+
+        std::array<Buffer, 3> buffers{};
+        /** the index of the buffer in the middle, with the dirty bit set if it has not been acquired */
+        alignas(64) std::atomic<uint8_t> middle{1};
+        std::atomic<size_t> version{0};
+        /** only accessed on the writer thread */
+        alignas(64) uint8_t backIdx{0};
+        size_t writerVersion{0};
+        /** only accessed on the reader thread */
+        alignas(64) uint8_t frontIdx{2};
+    };
+}
+
+#endif //ZLEQUALIZER_COEFF_SNAPSHOT_HPP
@@ -11,16 +11,28 @@
 #define IIR_BASE_HPP
 
 #include "coeff/design_filter.hpp"
+#include "simd_lanes.hpp"
 
 namespace zlIIR {
+    /**
+     * a 2nd order transposed direct form II filter
+     * stereo (and up to SIMD-width) blocks are processed with one channel per SIMD lane
+     * the lane kernel performs the same operations in the same order as processSample,
+     * so it matches the scalar path up to floating-point contraction (< 1e-12 for double, < 1e-6 for float)
+     * long blocks can also be processed in the block state-space form, see processBlock
+     * @tparam SampleType
+     */
     template<typename SampleType>
     class IIRBase {
     public:
+        /** the number of samples per block of the block state-space form */
+        static constexpr size_t blockSize = 16;
+
         IIRBase() = default;
 
         void prepare(const juce::dsp::ProcessSpec &spec) {
-            s1.resize(spec.numChannels);
-            s2.resize(spec.numChannels);
+            jassert(spec.numChannels <= Lanes<SampleType>::maxChannels);
+            juce::ignoreUnused(spec);
             reset();
         }
 
@@ -37,6 +49,18 @@ namespace zlIIR {
             }
         }
 
+        /**
+         * get the maximum magnitude of the states of all channels
+         * @return
+         */
+        SampleType getStatePeak() const {
+            SampleType peak{0};
+            for (size_t i = 0; i < s1.size(); ++i) {
+                peak = std::max(peak, std::max(std::abs(s1[i]), std::abs(s2[i])));
+            }
+            return peak;
+        }
+
         template<typename ProcessContext>
         void process(const ProcessContext &context) noexcept {
             const auto &inputBlock = context.getInputBlock();
@@ -48,7 +72,16 @@ namespace zlIIR {
             jassert(inputBlock.getNumChannels() == numChannels);
             jassert(inputBlock.getNumSamples() == numSamples);
 
-            if (context.isBypassed) {
+            if (Lanes<SampleType>::isAvailable(numChannels)) {
+                if (context.isBypassed) {
+                    if (context.usesSeparateInputAndOutputBlocks()) {
+                        outputBlock.copyFrom(inputBlock);
+                    }
+                    processLanes<true>(inputBlock, outputBlock);
+                } else {
+                    processLanes<false>(inputBlock, outputBlock);
+                }
+            } else if (context.isBypassed) {
                 if (context.usesSeparateInputAndOutputBlocks()) {
                     outputBlock.copyFrom(inputBlock);
                 }
@@ -89,12 +122,276 @@ namespace zlIIR {
             coeff[2] = static_cast<SampleType>(b[2] * a0Inv);
             coeff[3] = static_cast<SampleType>(a[1] * a0Inv);
             coeff[4] = static_cast<SampleType>(a[2] * a0Inv);
+            ssOutdated = true;
+        }
+
+        /**
+         * process a block in the block state-space form
+         * every blockSize outputs are computed from the state and the inputs as a matrix-vector product plus an FIR,
+         * so there is no sample-to-sample dependency inside a block
+         * the state is shared with process, hence the two modes can be switched without a reset
+         * @param context
+         */
+        template<typename ProcessContext>
+        void processBlock(const ProcessContext &context) noexcept {
+            const auto &inputBlock = context.getInputBlock();
+            auto &outputBlock = context.getOutputBlock();
+            const auto numChannels = outputBlock.getNumChannels();
+            const auto numSamples = outputBlock.getNumSamples();
+
+            jassert(inputBlock.getNumChannels() <= s1.size());
+            jassert(inputBlock.getNumChannels() == numChannels);
+            jassert(inputBlock.getNumSamples() == numSamples);
+
+            if (ssOutdated) {
+                updateStateSpace();
+            }
+            if (context.isBypassed) {
+                if (context.usesSeparateInputAndOutputBlocks()) {
+                    outputBlock.copyFrom(inputBlock);
+                }
+                for (size_t channel = 0; channel < numChannels; ++channel) {
+                    processChannelBlock<true>(channel, inputBlock.getChannelPointer(channel),
+                                              outputBlock.getChannelPointer(channel), numSamples);
+                }
+            } else {
+                for (size_t channel = 0; channel < numChannels; ++channel) {
+                    processChannelBlock<false>(channel, inputBlock.getChannelPointer(channel),
+                                               outputBlock.getChannelPointer(channel), numSamples);
+                }
+            }
+
+#if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+            snapToZero();
+#endif
+        }
+
+        /**
+         * process a lane-interleaved tile in place, the state stays in registers during the tile
+         * @tparam isBypassed whether the output is discarded (the state is still updated)
+         * @param tile numSamples x Lanes<SampleType>::size samples, aligned to Lanes<SampleType>::alignment
+         * @param numSamples
+         */
+        template<bool isBypassed>
+        void processTile(SampleType *tile, const size_t numSamples) noexcept {
+#if JUCE_USE_SIMD
+            using Register = typename Lanes<SampleType>::Register;
+            const auto b0 = Register::expand(coeff[0]), b1 = Register::expand(coeff[1]),
+                    b2 = Register::expand(coeff[2]), a1 = Register::expand(coeff[3]), a2 = Register::expand(coeff[4]);
+            auto r1 = Register::fromRawArray(s1.data());
+            auto r2 = Register::fromRawArray(s2.data());
+            for (size_t i = 0; i < numSamples; ++i) {
+                auto *x = tile + i * Lanes<SampleType>::size;
+                const auto inputValue = Register::fromRawArray(x);
+                const auto outputValue = inputValue * b0 + r1;
+                r1 = (inputValue * b1) - (outputValue * a1) + r2;
+                r2 = (inputValue * b2) - (outputValue * a2);
+                if constexpr (!isBypassed) {
+                    outputValue.copyToRawArray(x);
+                }
+            }
+            r1.copyToRawArray(s1.data());
+            r2.copyToRawArray(s2.data());
+#else
+            juce::ignoreUnused(tile, numSamples);
+#endif
+        }
+
+        /**
+         * process channel-interleaved frames in place, with a compile-time channel count
+         * the state is kept in local arrays, so the channel loop is unrolled (and vectorized) by the compiler
+         * @tparam NumChannels
+         * @tparam isBypassed whether the output is discarded (the state is still updated)
+         * @param frames numSamples x NumChannels samples, sample i of channel c is stored at [i * NumChannels + c]
+         * @param numSamples
+         */
+        template<size_t NumChannels, bool isBypassed>
+        void processFrames(SampleType *frames, const size_t numSamples) noexcept {
+            static_assert(NumChannels <= Lanes<SampleType>::maxChannels);
+            const auto b0 = coeff[0], b1 = coeff[1], b2 = coeff[2], a1 = coeff[3], a2 = coeff[4];
+            std::array<SampleType, NumChannels> r1, r2;
+            std::copy_n(s1.begin(), NumChannels, r1.begin());
+            std::copy_n(s2.begin(), NumChannels, r2.begin());
+            for (size_t i = 0; i < numSamples; ++i) {
+                auto *x = frames + i * NumChannels;
+                for (size_t channel = 0; channel < NumChannels; ++channel) {
+                    const auto inputValue = x[channel];
+                    const auto outputValue = inputValue * b0 + r1[channel];
+                    r1[channel] = (inputValue * b1) - (outputValue * a1) + r2[channel];
+                    r2[channel] = (inputValue * b2) - (outputValue * a2);
+                    if constexpr (!isBypassed) {
+                        x[channel] = outputValue;
+                    }
+                }
+            }
+            std::copy_n(r1.begin(), NumChannels, s1.begin());
+            std::copy_n(r2.begin(), NumChannels, s2.begin());
+        }
+
+        /**
+         * process a block in place while the coefficients move linearly to those of a biquad
+         * the target is reached at the last sample, and it is kept as the coefficients afterward
+         * the stability triangle of (a1, a2) is convex, so every intermediate section is stable
+         * @tparam isBypassed whether the output is discarded (the state is still updated)
+         * @param block
+         * @param target
+         */
+        template<bool isBypassed>
+        void processRamp(const juce::dsp::AudioBlock<SampleType> &block, const coeff33 &target) noexcept {
+            const auto start = coeff;
+            updateFromBiquad(target);
+            const auto numSamples = block.getNumSamples();
+            if (numSamples == 0) { return; }
+            const auto scale = SampleType(1) / static_cast<SampleType>(numSamples);
+            std::array<SampleType, 5> delta{};
+            for (size_t k = 0; k < delta.size(); ++k) {
+                delta[k] = (coeff[k] - start[k]) * scale;
+            }
+            for (size_t channel = 0; channel < block.getNumChannels(); ++channel) {
+                auto *samples = block.getChannelPointer(channel);
+                auto b0 = start[0], b1 = start[1], b2 = start[2], a1 = start[3], a2 = start[4];
+                auto r1 = s1[channel], r2 = s2[channel];
+                for (size_t i = 0; i < numSamples; ++i) {
+                    b0 += delta[0];
+                    b1 += delta[1];
+                    b2 += delta[2];
+                    a1 += delta[3];
+                    a2 += delta[4];
+                    const auto inputValue = samples[i];
+                    const auto outputValue = inputValue * b0 + r1;
+                    r1 = (inputValue * b1) - (outputValue * a1) + r2;
+                    r2 = (inputValue * b2) - (outputValue * a2);
+                    if constexpr (!isBypassed) {
+                        samples[i] = outputValue;
+                    }
+                }
+                s1[channel] = r1;
+                s2[channel] = r2;
+            }
         }
 
     private:
         std::array<SampleType, 5> coeff{0, 0, 0, 0, 0};
-        SampleType g, R2, h, chp, cbp, clp;
-        std::vector<SampleType> s1, s2;
+        alignas(Lanes<SampleType>::alignment) typename Lanes<SampleType>::Array s1{}, s2{};
+
+        /**
+         * block state-space form of the section, with s = [s1, s2] and x/y the inputs/outputs of a block
+         * y = [o1, o2] * s + toeplitz(h) * x
+         * s' = [[p11, p12], [p21, p22]] * s + [k1; k2] * x
+         */
+        alignas(Lanes<SampleType>::alignment) std::array<SampleType, blockSize> h{}, o1{}, o2{}, k1{}, k2{};
+        SampleType p11{1}, p12{0}, p21{0}, p22{1};
+        bool ssOutdated{true};
+
+        void updateStateSpace() {
+            // x[n] -> s[n + 1]: A = [[-a1, 1], [-a2, 0]], B = [b1 - a1 * b0, b2 - a2 * b0]
+            // y[n] = [1, 0] * s[n] + b0 * x[n]
+            const auto b0 = static_cast<double>(coeff[0]);
+            const auto a1 = static_cast<double>(coeff[3]), a2 = static_cast<double>(coeff[4]);
+            const auto bs1 = static_cast<double>(coeff[1]) - a1 * b0;
+            const auto bs2 = static_cast<double>(coeff[2]) - a2 * b0;
+            // observability rows [1, 0] * A^k and impulse response [1, 0] * A^(k-1) * B
+            double r1 = 1, r2 = 0;
+            h[0] = coeff[0];
+            for (size_t k = 0; k < blockSize; ++k) {
+                o1[k] = static_cast<SampleType>(r1);
+                o2[k] = static_cast<SampleType>(r2);
+                if (k + 1 < blockSize) {
+                    h[k + 1] = static_cast<SampleType>(r1 * bs1 + r2 * bs2);
+                }
+                const auto t = -a1 * r1 - a2 * r2;
+                r2 = r1;
+                r1 = t;
+            }
+            // controllability columns A^(blockSize-1-j) * B
+            double v1 = bs1, v2 = bs2;
+            for (size_t j = blockSize; j > 0; --j) {
+                k1[j - 1] = static_cast<SampleType>(v1);
+                k2[j - 1] = static_cast<SampleType>(v2);
+                const auto t = -a1 * v1 + v2;
+                v2 = -a2 * v1;
+                v1 = t;
+            }
+            // A^blockSize
+            double m11 = 1, m12 = 0, m21 = 0, m22 = 1;
+            for (size_t k = 0; k < blockSize; ++k) {
+                const auto n11 = -a1 * m11 + m21, n12 = -a1 * m12 + m22;
+                m21 = -a2 * m11;
+                m22 = -a2 * m12;
+                m11 = n11;
+                m12 = n12;
+            }
+            p11 = static_cast<SampleType>(m11);
+            p12 = static_cast<SampleType>(m12);
+            p21 = static_cast<SampleType>(m21);
+            p22 = static_cast<SampleType>(m22);
+            ssOutdated = false;
+        }
+
+        template<bool isBypassed>
+        void processChannelBlock(const size_t channel, const SampleType *inputSamples, SampleType *outputSamples,
+                                 const size_t numSamples) noexcept {
+            auto state1 = s1[channel], state2 = s2[channel];
+            size_t start = 0;
+            for (; start + blockSize <= numSamples; start += blockSize) {
+                const auto *x = inputSamples + start;
+                if constexpr (!isBypassed) {
+                    alignas(Lanes<SampleType>::alignment) std::array<SampleType, blockSize> y;
+                    for (size_t k = 0; k < blockSize; ++k) {
+                        y[k] = o1[k] * state1 + o2[k] * state2;
+                    }
+                    for (size_t j = 0; j < blockSize; ++j) {
+                        const auto xj = x[j];
+                        for (size_t k = j; k < blockSize; ++k) {
+                            y[k] += h[k - j] * xj;
+                        }
+                    }
+                    // the state update reads the inputs, so write the outputs afterward for in-place blocks
+                    auto next1 = p11 * state1 + p12 * state2;
+                    auto next2 = p21 * state1 + p22 * state2;
+                    for (size_t j = 0; j < blockSize; ++j) {
+                        next1 += k1[j] * x[j];
+                        next2 += k2[j] * x[j];
+                    }
+                    std::copy(y.begin(), y.end(), outputSamples + start);
+                    state1 = next1;
+                    state2 = next2;
+                } else {
+                    auto next1 = p11 * state1 + p12 * state2;
+                    auto next2 = p21 * state1 + p22 * state2;
+                    for (size_t j = 0; j < blockSize; ++j) {
+                        next1 += k1[j] * x[j];
+                        next2 += k2[j] * x[j];
+                    }
+                    state1 = next1;
+                    state2 = next2;
+                }
+            }
+            s1[channel] = state1;
+            s2[channel] = state2;
+            // the remaining samples are processed with the recursion
+            for (size_t i = start; i < numSamples; ++i) {
+                if constexpr (isBypassed) {
+                    processSample(channel, inputSamples[i]);
+                } else {
+                    outputSamples[i] = processSample(channel, inputSamples[i]);
+                }
+            }
+        }
+
+        template<bool isBypassed, typename InputBlockType, typename OutputBlockType>
+        void processLanes(const InputBlockType &inputBlock, const OutputBlockType &outputBlock) noexcept {
+            const auto numSamples = outputBlock.getNumSamples();
+            alignas(Lanes<SampleType>::alignment) typename Lanes<SampleType>::Tile tile{};
+            for (size_t start = 0; start < numSamples; start += Lanes<SampleType>::tileSize) {
+                const auto n = std::min(Lanes<SampleType>::tileSize, numSamples - start);
+                Lanes<SampleType>::toTile(inputBlock, start, n, tile.data());
+                processTile<isBypassed>(tile.data(), n);
+                if constexpr (!isBypassed) {
+                    Lanes<SampleType>::fromTile(tile.data(), start, n, outputBlock);
+                }
+            }
+        }
     };
 }
 
@@ -12,5 +12,6 @@
 
 #include "single_filter.hpp"
 #include "static_gain_compensation.hpp"
+#include "parallel_form.hpp"
 
 #endif //ZLEQUALIZER_IIR_FILTER_HPP
@@ -0,0 +1,224 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include "parallel_form.hpp"
+
+namespace zlIIR {
+    namespace {
+        struct Section {
+            double b0, b1, b2, a1, a2;
+
+            std::complex<double> numerator(const std::complex<double> w) const { return b0 + w * (b1 + w * b2); }
+
+            std::complex<double> denominator(const std::complex<double> w) const {
+                return 1.0 + w * (a1 + w * a2);
+            }
+
+            std::complex<double> response(const std::complex<double> w) const {
+                return numerator(w) / denominator(w);
+            }
+
+            bool isIdentity() const {
+                constexpr double eps = 1e-12;
+                return std::abs(b0 - 1) < eps && std::abs(b1 - a1) < eps && std::abs(b2 - a2) < eps;
+            }
+
+            size_t getNumeratorOrder() const { return b2 != 0 ? 2 : (b1 != 0 ? 1 : 0); }
+        };
+    }
+
+    template<typename FloatType>
+    bool ParallelForm<FloatType>::decompose(const coeff33 *cascade, const size_t num, ParallelCoeffs &parallel) {
+        parallel.num = 0;
+        parallel.direct = 1;
+        parallel.valid = false;
+        // normalize the sections and skip identity sections (e.g. peaks with 0 dB gain)
+        std::array<Section, ParallelCoeffs::maxSections> sections{};
+        std::array<std::array<std::complex<double>, 2>, ParallelCoeffs::maxSections> poles{};
+        std::array<size_t, ParallelCoeffs::maxSections> numPoles{};
+        size_t numSections = 0, numeratorOrder = 0, denominatorOrder = 0;
+        for (size_t i = 0; i < std::min(num, ParallelCoeffs::maxSections); ++i) {
+            const auto &a = std::get<0>(cascade[i]);
+            const auto &b = std::get<1>(cascade[i]);
+            const auto a0Inv = 1.0 / a[0];
+            const Section section{b[0] * a0Inv, b[1] * a0Inv, b[2] * a0Inv, a[1] * a0Inv, a[2] * a0Inv};
+            if (section.isIdentity()) { continue; }
+            // poles of z^2 + a1 z + a2, zero poles are dropped
+            auto &p = poles[numSections];
+            if (section.a2 != 0) {
+                const auto disc = section.a1 * section.a1 - 4 * section.a2;
+                if (disc >= 0) {
+                    const auto q = -0.5 * (section.a1 + std::copysign(std::sqrt(disc), section.a1));
+                    p[0] = q;
+                    p[1] = section.a2 / q;
+                } else {
+                    p[0] = std::complex<double>(-0.5 * section.a1, 0.5 * std::sqrt(-disc));
+                    p[1] = std::conj(p[0]);
+                }
+                numPoles[numSections] = 2;
+            } else if (section.a1 != 0) {
+                p[0] = -section.a1;
+                numPoles[numSections] = 1;
+            } else {
+                numPoles[numSections] = 0;
+            }
+            numeratorOrder += section.getNumeratorOrder();
+            denominatorOrder += numPoles[numSections];
+            sections[numSections] = section;
+            numSections += 1;
+        }
+        // a direct term is enough only if the numerator order does not exceed the denominator order
+        if (numeratorOrder > denominatorOrder) { return false; }
+
+        // residues at each pole: r = lim (1 - p z^-1) H, evaluated section by section to avoid overflow
+        double h0 = 1;
+        double residueSum = 0;
+        for (size_t k = 0; k < numSections; ++k) {
+            const auto &section = sections[k];
+            h0 *= section.b0;
+            std::array<std::complex<double>, 2> residues{};
+            for (size_t j = 0; j < numPoles[k]; ++j) {
+                const auto pole = poles[k][j];
+                const auto w = 1.0 / pole;
+                auto r = section.numerator(w);
+                if (numPoles[k] == 2) {
+                    r /= 1.0 - poles[k][1 - j] * w;
+                }
+                for (size_t i = 0; i < numSections; ++i) {
+                    if (i != k) { r *= sections[i].response(w); }
+                }
+                residues[j] = r;
+            }
+            auto &out = parallel.sections[parallel.num];
+            if (numPoles[k] == 2) {
+                out[0] = (residues[0] + residues[1]).real();
+                out[1] = -(residues[0] * poles[k][1] + residues[1] * poles[k][0]).real();
+            } else if (numPoles[k] == 1) {
+                out[0] = residues[0].real();
+                out[1] = 0;
+            } else {
+                continue;
+            }
+            out[2] = section.a1;
+            out[3] = section.a2;
+            residueSum += out[0];
+            parallel.num += 1;
+        }
+        parallel.direct = h0 - residueSum;
+
+        // validate the response (with FloatType coefficients) against the cascade
+        constexpr size_t numChecks = 64;
+        for (size_t i = 0; i < numChecks; ++i) {
+            const auto omega = std::numbers::pi * std::pow(10.0, -3.0 + 3.0 * static_cast<double>(i) /
+                                                                       static_cast<double>(numChecks)) * 0.999;
+            const auto w = std::polar(1.0, -omega);
+            std::complex<double> hCascade = 1;
+            for (size_t k = 0; k < numSections; ++k) {
+                hCascade *= sections[k].response(w);
+            }
+            const auto d = static_cast<double>(static_cast<FloatType>(parallel.direct));
+            std::complex<double> hParallel = d;
+            double noise = std::abs(d);
+            for (size_t k = 0; k < parallel.num; ++k) {
+                const auto &c = parallel.sections[k];
+                const auto hk = (static_cast<double>(static_cast<FloatType>(c[0])) +
+                                 static_cast<double>(static_cast<FloatType>(c[1])) * w) /
+                                (1.0 + w * (static_cast<double>(static_cast<FloatType>(c[2])) +
+                                            w * static_cast<double>(static_cast<FloatType>(c[3]))));
+                hParallel += hk;
+                noise += std::abs(hk);
+            }
+            const auto error = std::abs(hParallel - hCascade);
+            if (!std::isfinite(error) || error > tolerance * std::max(1.0, std::abs(hCascade)) ||
+                noise > noiseLimit) {
+                return false;
+            }
+        }
+        parallel.valid = true;
+        return true;
+    }
+
+    template<typename FloatType>
+    void ParallelForm<FloatType>::reset() {
+        for (auto &s: s1) { std::fill(s.begin(), s.end(), FloatType(0)); }
+        for (auto &s: s2) { std::fill(s.begin(), s.end(), FloatType(0)); }
+    }
+
+    template<typename FloatType>
+    void ParallelForm<FloatType>::setCoeffs(const ParallelCoeffs &parallel) {
+        if (parallel.num != numSections) {
+            reset();
+        }
+        numSections = parallel.num;
+        numGroups = (numSections + laneSize - 1) / laneSize;
+        for (size_t i = 0; i < numGroups * laneSize; ++i) {
+            if (i < numSections) {
+                const auto &c = parallel.sections[i];
+                b0[i] = static_cast<FloatType>(c[0]);
+                b1[i] = static_cast<FloatType>(c[1]);
+                a1[i] = static_cast<FloatType>(c[2]);
+                na2[i] = -static_cast<FloatType>(c[3]);
+            } else {
+                b0[i] = FloatType(0);
+                b1[i] = FloatType(0);
+                a1[i] = FloatType(0);
+                na2[i] = FloatType(0);
+            }
+        }
+        direct = static_cast<FloatType>(parallel.direct);
+    }
+
+    template<typename FloatType>
+    void ParallelForm<FloatType>::process(juce::dsp::AudioBlock<FloatType> block) noexcept {
+#if JUCE_USE_SIMD
+        using Register = typename Lanes<FloatType>::Register;
+        jassert(block.getNumChannels() <= maxChannels);
+        const auto numSamples = block.getNumSamples();
+        for (size_t channel = 0; channel < block.getNumChannels(); ++channel) {
+            auto *samples = block.getChannelPointer(channel);
+            for (size_t start = 0; start < numSamples; start += Lanes<FloatType>::tileSize) {
+                const auto n = std::min(Lanes<FloatType>::tileSize, numSamples - start);
+                std::fill(sums.begin(), sums.begin() + static_cast<std::ptrdiff_t>(n * laneSize), FloatType(0));
+                // each group of sections runs through the tile with its states in registers
+                for (size_t g = 0; g < numGroups; ++g) {
+                    const auto offset = g * laneSize;
+                    const auto rb0 = Register::fromRawArray(b0.data() + offset);
+                    const auto rb1 = Register::fromRawArray(b1.data() + offset);
+                    const auto ra1 = Register::fromRawArray(a1.data() + offset);
+                    const auto rna2 = Register::fromRawArray(na2.data() + offset);
+                    auto r1 = Register::fromRawArray(s1[channel].data() + offset);
+                    auto r2 = Register::fromRawArray(s2[channel].data() + offset);
+                    for (size_t i = 0; i < n; ++i) {
+                        const auto inputValue = Register::expand(samples[start + i]);
+                        const auto outputValue = inputValue * rb0 + r1;
+                        r1 = (inputValue * rb1) - (outputValue * ra1) + r2;
+                        r2 = outputValue * rna2;
+                        auto *sum = sums.data() + i * laneSize;
+                        (Register::fromRawArray(sum) + outputValue).copyToRawArray(sum);
+                    }
+                    r1.copyToRawArray(s1[channel].data() + offset);
+                    r2.copyToRawArray(s2[channel].data() + offset);
+                }
+                for (size_t i = 0; i < n; ++i) {
+                    samples[start + i] = samples[start + i] * direct +
+                                         Register::fromRawArray(sums.data() + i * laneSize).sum();
+                }
+            }
+        }
+#else
+        juce::ignoreUnused(block);
+#endif
+    }
+
+    template
+    class ParallelForm<float>;
+
+    template
+    class ParallelForm<double>;
+}
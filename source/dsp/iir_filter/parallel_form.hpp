@@ -0,0 +1,80 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_PARALLEL_FORM_HPP
+#define ZLEQUALIZER_PARALLEL_FORM_HPP
+
+#include "coeff/design_filter.hpp"
+#include "simd_lanes.hpp"
+
+namespace zlIIR {
+    /**
+     * coefficients of a parallel form filter, i.e. a direct term plus parallel sections {b0, b1, a1, a2}
+     * each section is (b0 + b1 z^-1) / (1 + a1 z^-1 + a2 z^-2)
+     */
+    struct ParallelCoeffs {
+        static constexpr size_t maxSections = 256;
+        std::array<std::array<double, 4>, maxSections> sections{};
+        size_t num{0};
+        double direct{1};
+        bool valid{false};
+        size_t version{0};
+    };
+
+    /**
+     * a parallel form (partial fraction) filter which replaces a cascade of 2nd order sections
+     * the parallel sections are independent, so that Lanes<FloatType>::size sections are processed in SIMD lanes
+     * @tparam FloatType
+     */
+    template<typename FloatType>
+    class ParallelForm {
+    public:
+        static constexpr size_t maxChannels = 2;
+
+        ParallelForm() = default;
+
+        /**
+         * decompose a cascade of 2nd order sections into a parallel form
+         * the decomposition fails if the cascade has (nearly) repeated poles, poles at zero,
+         * or if the parallel form is not accurate enough in FloatType
+         * @param cascade
+         * @param num the number of sections in the cascade
+         * @param parallel
+         * @return whether the parallel form can replace the cascade
+         */
+        static bool decompose(const coeff33 *cascade, size_t num, ParallelCoeffs &parallel);
+
+        void reset();
+
+        /**
+         * load the coefficients, the states are kept if the number of sections does not change
+         * @param parallel
+         */
+        void setCoeffs(const ParallelCoeffs &parallel);
+
+        void process(juce::dsp::AudioBlock<FloatType> block) noexcept;
+
+    private:
+        static constexpr size_t laneSize = Lanes<FloatType>::size;
+        static constexpr size_t maxSize = ParallelCoeffs::maxSections + laneSize;
+
+        // section coefficients (a2 is stored negated), grouped by laneSize, padded sections are zero
+        alignas(Lanes<FloatType>::alignment) std::array<FloatType, maxSize> b0{}, b1{}, a1{}, na2{};
+        alignas(Lanes<FloatType>::alignment) std::array<std::array<FloatType, maxSize>, maxChannels> s1{}, s2{};
+        FloatType direct{1};
+        size_t numSections{0}, numGroups{0};
+
+        alignas(Lanes<FloatType>::alignment) typename Lanes<FloatType>::Tile sums{};
+
+        static constexpr double tolerance = std::is_same_v<FloatType, float> ? 1e-3 : 1e-9;
+        static constexpr double noiseLimit = std::is_same_v<FloatType, float> ? 1e2 : 1e6;
+    };
+}
+
+#endif //ZLEQUALIZER_PARALLEL_FORM_HPP
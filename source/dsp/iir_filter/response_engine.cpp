@@ -0,0 +1,135 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include "response_engine.hpp"
+
+namespace zlIIR {
+    std::array<ResponseEngine::Table, ResponseEngine::tableNum> ResponseEngine::tables{};
+    size_t ResponseEngine::nextTable{0};
+    std::mutex ResponseEngine::tableMutex;
+
+    void ResponseEngine::multiplyGains(const std::array<coeff33, 16> &coeffs, const size_t num, const double fs,
+                                       std::array<double, frequencies.size()> &gains) {
+        alignas(64) std::array<double, frequencies.size()> numerators{}, denominators{};
+        std::fill(numerators.begin(), numerators.end(), 1.0);
+        std::fill(denominators.begin(), denominators.end(), 1.0);
+        {
+            const std::lock_guard<std::mutex> lock(tableMutex);
+            const auto &table = getTable(fs);
+            for (size_t i = 0; i < num; ++i) {
+                const auto A = toPhiBasis(std::get<0>(coeffs[i]));
+                const auto B = toPhiBasis(std::get<1>(coeffs[i]));
+                for (size_t k = 0; k < frequencies.size(); ++k) {
+                    numerators[k] *= B[0] * table.phi0[k] + B[1] * table.phi1[k] + B[2] * table.phi2[k];
+                    denominators[k] *= A[0] * table.phi0[k] + A[1] * table.phi1[k] + A[2] * table.phi2[k];
+                }
+            }
+        }
+        for (size_t k = 0; k < frequencies.size(); ++k) {
+            gains[k] *= std::sqrt(std::max(numerators[k], 0.0) / denominators[k]);
+        }
+    }
+
+    double ResponseEngine::getGain(const std::array<coeff33, 16> &coeffs, const size_t num,
+                                   const double fs, const double f) {
+        const auto s = std::sin(std::numbers::pi * f / fs);
+        const auto phi1 = s * s, phi0 = 1 - phi1, phi2 = 4 * phi0 * phi1;
+        double numerator = 1, denominator = 1;
+        for (size_t i = 0; i < num; ++i) {
+            const auto A = toPhiBasis(std::get<0>(coeffs[i]));
+            const auto B = toPhiBasis(std::get<1>(coeffs[i]));
+            numerator *= B[0] * phi0 + B[1] * phi1 + B[2] * phi2;
+            denominator *= A[0] * phi0 + A[1] * phi1 + A[2] * phi2;
+        }
+        return std::sqrt(std::max(numerator, 0.0) / denominator);
+    }
+
+    void ResponseEngine::multiplyResponses(const std::array<coeff33, 16> &coeffs, const size_t num, const double fs,
+                                           ComplexResponse &response) {
+        const std::lock_guard<std::mutex> lock(tableMutex);
+        const auto &table = getTable(fs);
+        const auto invFs = 1 / fs;
+        for (size_t i = 0; i < num; ++i) {
+            const auto &[a, b] = coeffs[i];
+            for (size_t k = 0; k < frequencies.size(); ++k) {
+                const auto c1 = table.cos1[k], s1 = table.sin1[k], c2 = table.cos2[k], s2 = table.sin2[k];
+                const auto br = b[0] + b[1] * c1 + b[2] * c2, bi = -(b[1] * s1 + b[2] * s2);
+                const auto ar = a[0] + a[1] * c1 + a[2] * c2, ai = -(a[1] * s1 + a[2] * s2);
+                const auto bm = std::max(br * br + bi * bi, std::numeric_limits<double>::min());
+                const auto am = std::max(ar * ar + ai * ai, std::numeric_limits<double>::min());
+                // group delays of the numerator and the denominator
+                const auto bdr = b[1] * c1 + 2 * b[2] * c2, bdi = -(b[1] * s1 + 2 * b[2] * s2);
+                const auto adr = a[1] * c1 + 2 * a[2] * c2, adi = -(a[1] * s1 + 2 * a[2] * s2);
+                response.delays[k] += ((bdr * br + bdi * bi) / bm - (adr * ar + adi * ai) / am) * invFs;
+                // H = B * conj(A) / |A|^2
+                const auto hr = (br * ar + bi * ai) / am, hi = (bi * ar - br * ai) / am;
+                const auto re = response.re[k], im = response.im[k];
+                response.re[k] = re * hr - im * hi;
+                response.im[k] = re * hi + im * hr;
+            }
+        }
+    }
+
+    void ResponseEngine::multiplyAnalogGains(const std::array<coeff33, 16> &coeffs, const size_t num, const double fs,
+                                             std::array<double, frequencies.size()> &gains) {
+        alignas(64) std::array<double, frequencies.size()> numerators{}, denominators{};
+        std::fill(numerators.begin(), numerators.end(), 1.0);
+        std::fill(denominators.begin(), denominators.end(), 1.0);
+        {
+            const std::lock_guard<std::mutex> lock(tableMutex);
+            const auto &table = getTable(fs);
+            for (size_t i = 0; i < num; ++i) {
+                const auto &[a, b] = coeffs[i];
+                for (size_t k = 0; k < frequencies.size(); ++k) {
+                    numerators[k] *= AnalogFunc::getMagnitude2(b, table.w2[k]);
+                    denominators[k] *= AnalogFunc::getMagnitude2(a, table.w2[k]);
+                }
+            }
+        }
+        for (size_t k = 0; k < frequencies.size(); ++k) {
+            gains[k] *= std::sqrt(numerators[k] / denominators[k]);
+        }
+    }
+
+    double ResponseEngine::getAnalogGain(const std::array<coeff33, 16> &coeffs, const size_t num,
+                                         const double fs, const double f) {
+        const auto w = 2 * std::numbers::pi * f / fs;
+        double numerator = 1, denominator = 1;
+        for (size_t i = 0; i < num; ++i) {
+            const auto &[a, b] = coeffs[i];
+            numerator *= AnalogFunc::getMagnitude2(b, w * w);
+            denominator *= AnalogFunc::getMagnitude2(a, w * w);
+        }
+        return std::sqrt(numerator / denominator);
+    }
+
+    const ResponseEngine::Table &ResponseEngine::getTable(const double fs) {
+        for (const auto &table: tables) {
+            if (table.fs == fs) {
+                return table;
+            }
+        }
+        auto &table = tables[nextTable];
+        nextTable = (nextTable + 1) % tableNum;
+        for (size_t k = 0; k < frequencies.size(); ++k) {
+            const auto s = std::sin(std::numbers::pi * frequencies[k] / fs);
+            table.phi1[k] = s * s;
+            table.phi0[k] = 1 - table.phi1[k];
+            table.phi2[k] = 4 * table.phi0[k] * table.phi1[k];
+            const auto w = 2 * std::numbers::pi * frequencies[k] / fs;
+            table.w2[k] = w * w;
+            table.cos1[k] = std::cos(w);
+            table.sin1[k] = std::sin(w);
+            table.cos2[k] = std::cos(2 * w);
+            table.sin2[k] = std::sin(2 * w);
+        }
+        table.fs = fs;
+        return table;
+    }
+}
@@ -0,0 +1,160 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_RESPONSE_ENGINE_HPP
+#define ZLEQUALIZER_RESPONSE_ENGINE_HPP
+
+#include <limits>
+#include <mutex>
+#include "coeff/design_filter.hpp"
+#include "static_frequency_array.hpp"
+
+namespace zlIIR {
+    /**
+     * evaluates the magnitude responses of cascades of 2nd order sections on the fixed frequency grid
+     * |a0 + a1 z^-1 + a2 z^-2|^2 = (a0 + a1 + a2)^2 * phi0 + (a0 - a1 + a2)^2 * phi1 - 4 * a0 * a2 * phi2,
+     * where phi1 = sin^2(w/2), phi0 = 1 - phi1 and phi2 = 4 * phi0 * phi1 (see MartinCoeff::get_AB)
+     * the analog prototypes are evaluated in closed form as well, |p0 + p1 s + p2 s^2|^2 = (p0 - p2 * w^2)^2 + p1^2 * w^2
+     * the complex responses (for phase and group delay) use P(e^-jw) = p0 + p1 e^-jw + p2 e^-2jw,
+     * whose group delay is Re(D * conj(P)) / |P|^2 with D = p1 e^-jw + 2 * p2 e^-2jw
+     * the phis (w^2, cos/sin) of the grid are tabulated per sample rate, so the evaluation is a few multiply-adds
+     * per point, the loops over the grid are vectorized by the compiler and nothing is allocated
+     * it is meant for non-realtime threads, the tables are shared by all filters and guarded by a lock
+     */
+    class ResponseEngine {
+    public:
+        /** the number of sample rates whose tables are kept */
+        static constexpr size_t tableNum = 4;
+
+        /**
+         * the complex response of cascades on the grid, sections (and filters in series) are accumulated into it
+         */
+        struct ComplexResponse {
+            /** the real and imaginary parts of the product of the responses */
+            alignas(64) std::array<double, frequencies.size()> re{}, im{};
+            /** the sum of the group delays, in seconds */
+            alignas(64) std::array<double, frequencies.size()> delays{};
+
+            /**
+             * reset to the response of a wire
+             */
+            void reset() {
+                re.fill(1.0);
+                im.fill(0.0);
+                delays.fill(0.0);
+            }
+
+            double getGain(const size_t k) const { return std::sqrt(re[k] * re[k] + im[k] * im[k]); }
+
+            /**
+             * @return the phase in [-pi, pi]
+             */
+            double getPhase(const size_t k) const { return std::atan2(im[k], re[k]); }
+        };
+
+        /**
+         * multiply the magnitude responses of the sections at zlIIR::frequencies into gains
+         * @param coeffs
+         * @param num the number of sections
+         * @param fs sample rate
+         * @param gains
+         */
+        static void multiplyGains(const std::array<coeff33, 16> &coeffs, size_t num, double fs,
+                                  std::array<double, frequencies.size()> &gains);
+
+        /**
+         * get the magnitude response of the sections at a single frequency
+         * @param coeffs
+         * @param num the number of sections
+         * @param fs sample rate
+         * @param f frequency
+         * @return
+         */
+        static double getGain(const std::array<coeff33, 16> &coeffs, size_t num, double fs, double f);
+
+        /**
+         * multiply the complex responses of the sections at zlIIR::frequencies into response,
+         * magnitude, phase and group delay are evaluated in the same pass
+         * @param coeffs
+         * @param num the number of sections
+         * @param fs sample rate
+         * @param response
+         */
+        static void multiplyResponses(const std::array<coeff33, 16> &coeffs, size_t num, double fs,
+                                      ComplexResponse &response);
+
+        /**
+         * the matched designs follow their analog prototypes closely up to about pi/4 (within 0.15 dB),
+         * towards Nyquist they deviate by up to a few dB
+         */
+        static constexpr double analogMaxW = std::numbers::pi / 4;
+
+        /**
+         * check whether the analog prototype response matches the designed filter on the whole grid
+         * the matched band-pass deviates from its prototype at low frequencies, so it is never replaced
+         * @param filterType
+         * @param fs sample rate
+         * @return
+         */
+        static bool isAnalogMatched(const FilterType filterType, const double fs) {
+            return filterType != FilterType::bandPass &&
+                   2 * std::numbers::pi * frequencies.back() / fs <= analogMaxW;
+        }
+
+        /**
+         * multiply the magnitude responses of the analog prototype sections (see AnalogFunc) into gains
+         * @param coeffs
+         * @param num the number of sections
+         * @param fs sample rate
+         * @param gains
+         */
+        static void multiplyAnalogGains(const std::array<coeff33, 16> &coeffs, size_t num, double fs,
+                                        std::array<double, frequencies.size()> &gains);
+
+        /**
+         * get the magnitude response of the analog prototype sections at a single frequency
+         * @param coeffs
+         * @param num the number of sections
+         * @param fs sample rate
+         * @param f frequency
+         * @return
+         */
+        static double getAnalogGain(const std::array<coeff33, 16> &coeffs, size_t num, double fs, double f);
+
+    private:
+        struct Table {
+            double fs{0};
+            alignas(64) std::array<double, frequencies.size()> phi0{}, phi1{}, phi2{};
+            /** the squared normalized angular frequencies, for the analog prototypes */
+            alignas(64) std::array<double, frequencies.size()> w2{};
+            /** cos(w), sin(w), cos(2w), sin(2w), for the complex responses */
+            alignas(64) std::array<double, frequencies.size()> cos1{}, sin1{}, cos2{}, sin2{};
+        };
+
+        static std::array<Table, tableNum> tables;
+        static size_t nextTable;
+        static std::mutex tableMutex;
+
+        /**
+         * find the table of the sample rate, or fill the oldest one, call it with the lock held
+         */
+        static const Table &getTable(double fs);
+
+        /**
+         * the squared magnitude of a polynomial in the phi basis
+         */
+        static std::array<double, 3> toPhiBasis(const coeff3 &p) {
+            return {(p[0] + p[1] + p[2]) * (p[0] + p[1] + p[2]),
+                    (p[0] - p[1] + p[2]) * (p[0] - p[1] + p[2]),
+                    -4 * p[0] * p[2]};
+        }
+    };
+}
+
+#endif //ZLEQUALIZER_RESPONSE_ENGINE_HPP
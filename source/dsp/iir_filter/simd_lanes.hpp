@@ -0,0 +1,110 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_SIMD_LANES_HPP
+#define ZLEQUALIZER_SIMD_LANES_HPP
+
+#include <juce_dsp/juce_dsp.h>
+
+namespace zlIIR {
+    /**
+     * lane layout of the SIMD kernels of 2nd order filters
+     * each channel occupies one lane of a SIMD register (SSE2/NEON: 2 x double or 4 x float)
+     * so that L/R are filtered with a single instruction stream
+     * @tparam SampleType
+     */
+    template<typename SampleType>
+    struct Lanes {
+#if JUCE_USE_SIMD
+        using Register = juce::dsp::SIMDRegister<SampleType>;
+        static constexpr size_t size = Register::SIMDNumElements;
+        static constexpr size_t alignment = Register::SIMDRegisterSize;
+#else
+        static constexpr size_t size = 1;
+        static constexpr size_t alignment = alignof(SampleType);
+#endif
+        /** the maximum number of channels whose states are stored inline */
+        static constexpr size_t maxChannels = std::max(static_cast<size_t>(8), size);
+
+        using Array = std::array<SampleType, maxChannels>;
+
+        /** the number of samples per channel in a tile */
+        static constexpr size_t tileSize = 64;
+
+        /** lane-interleaved samples, sample i of channel c is stored at [i * size + c] */
+        using Tile = std::array<SampleType, tileSize * size>;
+
+        /**
+         * check whether the CPU supports the SIMD kernel, the CPU feature is queried once at runtime
+         * @return
+         */
+        static bool isSupported() {
+            static const bool hasSIMD = checkCPU();
+            return hasSIMD;
+        }
+
+        /**
+         * check whether the SIMD kernel should process a block with numChannels channels
+         * @param numChannels
+         * @return
+         */
+        static bool isAvailable(const size_t numChannels) {
+            return isSupported() && numChannels > 1 && numChannels <= size;
+        }
+
+        /**
+         * copy samples of all channels of a block into a lane-interleaved tile
+         * @param block
+         * @param startSample
+         * @param numSamples must not exceed tileSize
+         * @param tile
+         */
+        template<typename BlockType>
+        static void toTile(const BlockType &block, const size_t startSample, const size_t numSamples,
+                           SampleType *tile) noexcept {
+            for (size_t channel = 0; channel < block.getNumChannels(); ++channel) {
+                const auto *samples = block.getChannelPointer(channel) + startSample;
+                for (size_t i = 0; i < numSamples; ++i) {
+                    tile[i * size + channel] = samples[i];
+                }
+            }
+        }
+
+        /**
+         * copy samples from a lane-interleaved tile back into all channels of a block
+         * @param tile
+         * @param startSample
+         * @param numSamples must not exceed tileSize
+         * @param block
+         */
+        template<typename BlockType>
+        static void fromTile(const SampleType *tile, const size_t startSample, const size_t numSamples,
+                             const BlockType &block) noexcept {
+            for (size_t channel = 0; channel < block.getNumChannels(); ++channel) {
+                auto *samples = block.getChannelPointer(channel) + startSample;
+                for (size_t i = 0; i < numSamples; ++i) {
+                    samples[i] = tile[i * size + channel];
+                }
+            }
+        }
+
+    private:
+        static bool checkCPU() {
+#if JUCE_USE_SIMD && JUCE_INTEL
+            return juce::SystemStats::hasSSE2();
+#elif JUCE_USE_SIMD && JUCE_ARM
+            return juce::SystemStats::hasNeon();
+#else
+            return false;
+#endif
+        }
+    };
+}
+
+#endif //ZLEQUALIZER_SIMD_LANES_HPP
@@ -38,7 +38,103 @@ namespace zlIIR {
     }
 
     template<typename FloatType>
-    void Filter<FloatType>::process(juce::AudioBuffer<FloatType> &buffer, bool isBypassed) {
+    void Filter<FloatType>::process(juce::AudioBuffer<FloatType> &buffer, const bool isBypassed) {
+        const auto currentBypass = prepareBlock(isBypassed);
+        const auto isInputSilent = needsInputCheck() && isSilent(buffer);
+        if (skipIdle(isInputSilent)) { return; }
+        auto block = juce::dsp::AudioBlock<FloatType>(buffer);
+        if (!currentUseSVF) {
+            if (useBlockSS.load()) {
+                auto context = juce::dsp::ProcessContextReplacing<FloatType>(block);
+                context.isBypassed = currentBypass;
+                for (size_t i = 0; i < filterNum.load(); ++i) {
+                    filters[i].processBlock(context);
+                }
+            } else {
+                processCascade(filters, block, currentBypass);
+            }
+        } else {
+            processCascade(svfFilters, block, currentBypass);
+        }
+        updateIdle(isInputSilent);
+    }
+
+    template<typename FloatType>
+    void Filter<FloatType>::processRamp(juce::AudioBuffer<FloatType> &buffer, const bool isBypassed) {
+        // a reset (e.g. of the type or the order) breaks the continuity of the coefficients
+        if (toReset.load() || currentUseSVF != useSVF.load()) {
+            process(buffer, isBypassed);
+            return;
+        }
+        const auto currentBypass = isBypassed || bypassNextBlock.exchange(false);
+        const auto num = filterNum.load();
+        const auto isUpdated = updateParasForDBOnly();
+        const auto isInputSilent = needsInputCheck() && isSilent(buffer);
+        if (skipIdle(isInputSilent)) {
+            if (isUpdated) { loadCoeffs(); }
+            return;
+        }
+        const auto block = juce::dsp::AudioBlock<FloatType>(buffer);
+        if (isUpdated && num == filterNum.load()) {
+            if (!currentUseSVF) {
+                processRampSections(filters, block, currentBypass);
+            } else {
+                processRampSections(svfFilters, block, currentBypass);
+            }
+        } else {
+            if (isUpdated) { loadCoeffs(); }
+            if (!currentUseSVF) {
+                processCascade(filters, block, currentBypass);
+            } else {
+                processCascade(svfFilters, block, currentBypass);
+            }
+        }
+        updateIdle(isInputSilent);
+    }
+
+    template<typename FloatType>
+    void Filter<FloatType>::processTo(const juce::dsp::AudioBlock<const FloatType> inputBlock,
+                                      juce::dsp::AudioBlock<FloatType> outputBlock, const bool isBypassed) {
+        const auto currentBypass = prepareBlock(isBypassed);
+        const auto isInputSilent = needsInputCheck() && isSilent(inputBlock);
+        const auto num = filterNum.load();
+        if (num == 0 || skipIdle(isInputSilent)) {
+            outputBlock.copyFrom(inputBlock);
+            return;
+        }
+        auto nonReplacing = juce::dsp::ProcessContextNonReplacing<FloatType>(inputBlock, outputBlock);
+        nonReplacing.isBypassed = currentBypass;
+        auto replacing = juce::dsp::ProcessContextReplacing<FloatType>(outputBlock);
+        replacing.isBypassed = currentBypass;
+        if (!currentUseSVF) {
+            filters[0].process(nonReplacing);
+            for (size_t i = 1; i < num; ++i) {
+                filters[i].process(replacing);
+            }
+        } else {
+            svfFilters[0].process(nonReplacing);
+            for (size_t i = 1; i < num; ++i) {
+                svfFilters[i].process(replacing);
+            }
+        }
+        updateIdle(isInputSilent);
+    }
+
+    template<typename FloatType>
+    template<typename BaseType>
+    void Filter<FloatType>::processRampSections(std::array<BaseType, 16> &bases,
+                                                const juce::dsp::AudioBlock<FloatType> &block, const bool isBypassed) {
+        for (size_t i = 0; i < filterNum.load(); ++i) {
+            if (isBypassed) {
+                bases[i].template processRamp<true>(block, coeffs[i]);
+            } else {
+                bases[i].template processRamp<false>(block, coeffs[i]);
+            }
+        }
+    }
+
+    template<typename FloatType>
+    bool Filter<FloatType>::prepareBlock(const bool isBypassed) {
         const auto nextUseSVF = useSVF.load();
         if (currentUseSVF != nextUseSVF) {
             currentUseSVF = nextUseSVF;
@@ -47,18 +143,184 @@ namespace zlIIR {
         }
         reset();
         updateParas();
-        auto block = juce::dsp::AudioBlock<FloatType>(buffer);
-        auto context = juce::dsp::ProcessContextReplacing<FloatType>(block);
-        context.isBypassed = isBypassed || bypassNextBlock.exchange(false);
+        return isBypassed || bypassNextBlock.exchange(false);
+    }
+
+    template<typename FloatType>
+    bool Filter<FloatType>::skipIdle(const bool isInputSilent) {
+        if (!isIdle) { return false; }
+        if (isInputSilent) {
+            idleBlocks.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        isIdle = false;
+        return false;
+    }
+
+    template<typename FloatType>
+    bool Filter<FloatType>::isStateSilent() const {
+        const auto num = filterNum.load();
+        FloatType peak{0};
         if (!currentUseSVF) {
-            for (size_t i = 0; i < filterNum.load(); ++i) {
-                filters[i].process(context);
+            for (size_t i = 0; i < num; ++i) {
+                peak = std::max(peak, filters[i].getStatePeak());
             }
         } else {
-            for (size_t i = 0; i < filterNum.load(); ++i) {
-                svfFilters[i].process(context);
+            for (size_t i = 0; i < num; ++i) {
+                peak = std::max(peak, svfFilters[i].getStatePeak());
             }
         }
+        return peak < idleThreshold;
+    }
+
+    template<typename FloatType>
+    void Filter<FloatType>::updateIdle(const bool isInputSilent) {
+        if (isIdle || !isInputSilent) { return; }
+        const auto num = filterNum.load();
+        if (isStateSilent()) {
+            for (size_t i = 0; i < num; ++i) {
+                filters[i].reset();
+                svfFilters[i].reset();
+            }
+            isIdle = true;
+        }
+    }
+
+    template<typename FloatType>
+    template<typename BaseType>
+    void Filter<FloatType>::processCascade(std::array<BaseType, 16> &bases,
+                                           juce::dsp::AudioBlock<FloatType> block, const bool isBypassed) {
+        const auto num = filterNum.load();
+        const auto blockChannels = block.getNumChannels();
+        const auto numSamples = block.getNumSamples();
+        // the SIMD lane tile serves multichannel cascades, the specialized scalar kernels serve the other shapes
+        // (mono routes, single sections, more channels than lanes, or no SIMD support)
+        const auto useLanes = num > 1 && Lanes<FloatType>::isAvailable(blockChannels);
+        const auto channelIdx = static_cast<size_t>(
+            std::find(fixedChannels.begin(), fixedChannels.end(), blockChannels) - fixedChannels.begin());
+        if (!useLanes && sectionIdx != invalidIdx && channelIdx < fixedChannels.size()) {
+            const auto kernel = getKernels<BaseType>()[channelIdx * fixedSections.size() + sectionIdx];
+            (this->*kernel)(bases, block, isBypassed);
+            return;
+        }
+        if (num <= 1 || !Lanes<FloatType>::isSupported() || blockChannels > Lanes<FloatType>::size) {
+            auto context = juce::dsp::ProcessContextReplacing<FloatType>(block);
+            context.isBypassed = isBypassed;
+            for (size_t i = 0; i < num; ++i) {
+                bases[i].process(context);
+            }
+            return;
+        }
+        // depth-first: each tile passes through all sections before the next tile is loaded
+        for (size_t start = 0; start < numSamples; start += Lanes<FloatType>::tileSize) {
+            const auto n = std::min(Lanes<FloatType>::tileSize, numSamples - start);
+            Lanes<FloatType>::toTile(block, start, n, tile.data());
+            if (isBypassed) {
+                for (size_t i = 0; i < num; ++i) {
+                    bases[i].template processTile<true>(tile.data(), n);
+                }
+            } else {
+                for (size_t i = 0; i < num; ++i) {
+                    bases[i].template processTile<false>(tile.data(), n);
+                }
+            }
+            Lanes<FloatType>::fromTile(tile.data(), start, n, block);
+        }
+#if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+        for (size_t i = 0; i < num; ++i) {
+            bases[i].snapToZero();
+        }
+#endif
+    }
+
+    template<typename FloatType>
+    template<typename BaseType, size_t NumChannels, size_t NumSections>
+    void Filter<FloatType>::processFixed(std::array<BaseType, 16> &bases,
+                                         juce::dsp::AudioBlock<FloatType> block, const bool isBypassed) {
+        if (isBypassed) {
+            processFixedFrames<BaseType, NumChannels, NumSections, true>(bases, block);
+        } else {
+            processFixedFrames<BaseType, NumChannels, NumSections, false>(bases, block);
+        }
+#if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+        for (size_t i = 0; i < NumSections; ++i) {
+            bases[i].snapToZero();
+        }
+#endif
+    }
+
+    template<typename FloatType>
+    template<typename BaseType, size_t NumChannels, size_t NumSections, bool isBypassed>
+    void Filter<FloatType>::processFixedFrames(std::array<BaseType, 16> &bases,
+                                               juce::dsp::AudioBlock<FloatType> block) {
+        constexpr auto tileSize = Lanes<FloatType>::tileSize;
+        const auto numSamples = block.getNumSamples();
+        for (size_t start = 0; start < numSamples; start += tileSize) {
+            const auto n = std::min(tileSize, numSamples - start);
+            if constexpr (NumChannels == 1) {
+                // a single channel is already interleaved
+                auto *samples = block.getChannelPointer(0) + start;
+                for (size_t i = 0; i < NumSections; ++i) {
+                    bases[i].template processFrames<1, isBypassed>(samples, n);
+                }
+            } else {
+                for (size_t channel = 0; channel < NumChannels; ++channel) {
+                    const auto *samples = block.getChannelPointer(channel) + start;
+                    for (size_t i = 0; i < n; ++i) {
+                        frames[i * NumChannels + channel] = samples[i];
+                    }
+                }
+                for (size_t i = 0; i < NumSections; ++i) {
+                    bases[i].template processFrames<NumChannels, isBypassed>(frames.data(), n);
+                }
+                for (size_t channel = 0; channel < NumChannels; ++channel) {
+                    auto *samples = block.getChannelPointer(channel) + start;
+                    for (size_t i = 0; i < n; ++i) {
+                        samples[i] = frames[i * NumChannels + channel];
+                    }
+                }
+            }
+        }
+    }
+
+    template<typename FloatType>
+    template<typename BaseType>
+    const std::array<typename Filter<FloatType>::template Kernel<BaseType>, Filter<FloatType>::kernelNum> &
+    Filter<FloatType>::getKernels() {
+        static constexpr auto kernels = makeKernels<BaseType>(std::make_index_sequence<kernelNum>());
+        return kernels;
+    }
+
+    template<typename FloatType>
+    void Filter<FloatType>::updateSectionIdx() {
+        const auto num = filterNum.load();
+        const auto idx = static_cast<size_t>(
+            std::find(fixedSections.begin(), fixedSections.end(), num) - fixedSections.begin());
+        sectionIdx = idx < fixedSections.size() ? idx : invalidIdx;
+    }
+
+    template<typename FloatType>
+    void Filter<FloatType>::updateTail() {
+        double radius = 0;
+        for (size_t i = 0; i < filterNum.load(); ++i) {
+            const auto a = std::get<0>(coeffs[i]);
+            const auto p1 = a[1] / a[0], p2 = a[2] / a[0];
+            const auto d = p1 * p1 - 4 * p2;
+            if (d < 0) {
+                radius = std::max(radius, std::sqrt(p2));
+            } else {
+                const auto sqrtD = std::sqrt(d);
+                radius = std::max(radius, std::max(std::abs(-p1 + sqrtD), std::abs(-p1 - sqrtD)) * 0.5);
+            }
+        }
+        if (radius <= 0) {
+            tailSeconds.store(0);
+        } else if (radius >= 1) {
+            tailSeconds.store(maxTailSeconds);
+        } else {
+            const auto tailSamples = std::log(static_cast<double>(idleThreshold)) / std::log(radius);
+            tailSeconds.store(std::min(tailSamples / processSpec.sampleRate, maxTailSeconds));
+        }
     }
 
     template<typename FloatType>
@@ -117,43 +379,43 @@ namespace zlIIR {
 
     template<typename FloatType>
     bool Filter<FloatType>::updateParas() {
-        if (toUpdatePara.exchange(false)) {
-            filterNum.store(DesignFilter::updateCoeff(filterType.load(),
-                                                      freq.load(), processSpec.sampleRate,
-                                                      gain.load(), q.load(), order.load(), coeffs)); {
-                farbot::RealtimeObject<
-                    std::array<coeff33, 16>,
-                    farbot::RealtimeObjectOptions::realtimeMutatable>::ScopedAccess<
-                    farbot::ThreadType::realtime> rrcentCoeffs(recentCoeffs);
-                *rrcentCoeffs = coeffs;
-            }
-            magOutdated.store(true);
-            if (!currentUseSVF) {
-                for (size_t i = 0; i < filterNum.load(); i++) {
-                    filters[i].updateFromBiquad(coeffs[i]);
-                }
-            } else {
-                for (size_t i = 0; i < filterNum.load(); i++) {
-                    svfFilters[i].updateFromBiquad(coeffs[i]);
-                }
-            }
+        if (updateParasForDBOnly()) {
+            loadCoeffs();
             return true;
         }
         return false;
     }
 
+    template<typename FloatType>
+    void Filter<FloatType>::loadCoeffs() {
+        if (!currentUseSVF) {
+            for (size_t i = 0; i < filterNum.load(); i++) {
+                filters[i].updateFromBiquad(coeffs[i]);
+            }
+        } else {
+            for (size_t i = 0; i < filterNum.load(); i++) {
+                svfFilters[i].updateFromBiquad(coeffs[i]);
+            }
+        }
+    }
+
     template<typename FloatType>
     bool Filter<FloatType>::updateParasForDBOnly() {
         if (toUpdatePara.exchange(false)) {
-            filterNum.store(DesignFilter::updateCoeff(filterType.load(),
-                                                      freq.load(), processSpec.sampleRate,
-                                                      gain.load(), q.load(), order.load(), coeffs)); {
-                farbot::RealtimeObject<
-                    std::array<coeff33, 16>,
-                    farbot::RealtimeObjectOptions::realtimeMutatable>::ScopedAccess<
-                    farbot::ThreadType::realtime> rrcentCoeffs(recentCoeffs);
-                *rrcentCoeffs = coeffs;
+            if (coeffCache != nullptr) {
+                filterNum.store(coeffCache->updateCoeff(filterType.load(),
+                                                        freq.load(), processSpec.sampleRate,
+                                                        gain.load(), q.load(), order.load(), coeffs,
+                                                        useFastMath.load()));
+            } else {
+                filterNum.store(DesignFilter::updateCoeff(filterType.load(),
+                                                          freq.load(), processSpec.sampleRate,
+                                                          gain.load(), q.load(), order.load(), coeffs,
+                                                          useFastMath.load()));
             }
+            updateSectionIdx();
+            updateTail();
+            coeffSnapshot.publish(coeffs, filterNum.load());
             magOutdated.store(true);
             return true;
         }
@@ -178,25 +440,16 @@ namespace zlIIR {
             return;
         }
         gains.fill(FloatType(1));
-        std::array<double, frequencies.size()> singleMagnitudes{};
-        juce::dsp::IIR::Coefficients<FloatType> dummyCoeff;
-        farbot::RealtimeObject<
-            std::array<coeff33, 16>,
-            farbot::RealtimeObjectOptions::realtimeMutatable>::ScopedAccess<
-            farbot::ThreadType::nonRealtime> rrcentCoeffs(recentCoeffs);
-        for (size_t i = 0; i < filterNum.load(); i++) {
-            dummyCoeff = {
-                static_cast<FloatType>(std::get<1>((*rrcentCoeffs)[i])[0]),
-                static_cast<FloatType>(std::get<1>((*rrcentCoeffs)[i])[1]),
-                static_cast<FloatType>(std::get<1>((*rrcentCoeffs)[i])[2]),
-                static_cast<FloatType>(std::get<0>((*rrcentCoeffs)[i])[0]),
-                static_cast<FloatType>(std::get<0>((*rrcentCoeffs)[i])[1]),
-                static_cast<FloatType>(std::get<0>((*rrcentCoeffs)[i])[2])
-            };
-            dummyCoeff.getMagnitudeForFrequencyArray(&frequencies[0], &singleMagnitudes[0],
-                                                     frequencies.size(), sampleRate.load());
-            std::transform(gains.begin(), gains.end(), singleMagnitudes.begin(), gains.begin(),
-                           std::multiplies<double>());
+        const auto fs = static_cast<double>(sampleRate.load());
+        currentAnalogCurve = useAnalogCurve.load() && ResponseEngine::isAnalogMatched(filterType.load(), fs);
+        if (currentAnalogCurve) {
+            analogNum = DesignFilter::updateAnalogCoeff(filterType.load(), freq.load(), fs,
+                                                        gain.load(), q.load(), order.load(), analogCoeffs);
+            ResponseEngine::multiplyAnalogGains(analogCoeffs, analogNum, fs, gains);
+        } else {
+            coeffSnapshot.acquire();
+            const auto &snapshot = coeffSnapshot.getFront();
+            ResponseEngine::multiplyGains(snapshot.coeffs, snapshot.num, fs, gains);
         }
         std::transform(gains.begin(), gains.end(), dBs.begin(),
                        [](auto &c) { return juce::Decibels::gainToDecibels(c, -240.0); });
@@ -216,26 +469,25 @@ namespace zlIIR {
 
     template<typename FloatType>
     FloatType Filter<FloatType>::getDB(FloatType f) {
-        double g{FloatType(1)};
-        juce::dsp::IIR::Coefficients<FloatType> dummyCoeff;
-        farbot::RealtimeObject<
-            std::array<coeff33, 16>,
-            farbot::RealtimeObjectOptions::realtimeMutatable>::ScopedAccess<
-            farbot::ThreadType::nonRealtime> rrcentCoeffs(recentCoeffs);
-        for (size_t i = 0; i < filterNum.load(); i++) {
-            dummyCoeff = {
-                static_cast<FloatType>(std::get<1>((*rrcentCoeffs)[i])[0]),
-                static_cast<FloatType>(std::get<1>((*rrcentCoeffs)[i])[1]),
-                static_cast<FloatType>(std::get<1>((*rrcentCoeffs)[i])[2]),
-                static_cast<FloatType>(std::get<0>((*rrcentCoeffs)[i])[0]),
-                static_cast<FloatType>(std::get<0>((*rrcentCoeffs)[i])[1]),
-                static_cast<FloatType>(std::get<0>((*rrcentCoeffs)[i])[2])
-            };
-            g *= dummyCoeff.getMagnitudeForFrequency(static_cast<double>(f), sampleRate.load());
+        if (currentAnalogCurve) {
+            const auto g = ResponseEngine::getAnalogGain(analogCoeffs, analogNum,
+                                                         sampleRate.load(), static_cast<double>(f));
+            return juce::Decibels::gainToDecibels(static_cast<FloatType>(g), FloatType(-240));
         }
+        coeffSnapshot.acquire();
+        const auto &snapshot = coeffSnapshot.getFront();
+        const auto g = ResponseEngine::getGain(snapshot.coeffs, snapshot.num,
+                                               sampleRate.load(), static_cast<double>(f));
         return juce::Decibels::gainToDecibels(static_cast<FloatType>(g), FloatType(-240));
     }
 
+    template<typename FloatType>
+    void Filter<FloatType>::multiplyResponses(ResponseEngine::ComplexResponse &response) {
+        coeffSnapshot.acquire();
+        const auto &snapshot = coeffSnapshot.getFront();
+        ResponseEngine::multiplyResponses(snapshot.coeffs, snapshot.num, sampleRate.load(), response);
+    }
+
     template
     class Filter<float>;
 
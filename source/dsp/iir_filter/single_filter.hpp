@@ -12,10 +12,12 @@
 
 #include <juce_dsp/juce_dsp.h>
 #include "coeff/design_filter.hpp"
+#include "coeff/coeff_cache.hpp"
 #include "static_frequency_array.hpp"
+#include "response_engine.hpp"
 #include "iir_base.hpp"
 #include "svf_base.hpp"
-#include "../farbot/RealtimeObject.hpp"
+#include "coeff_snapshot.hpp"
 
 namespace zlIIR {
     /**
@@ -23,6 +25,9 @@ namespace zlIIR {
      * it processes audio the the real-time thread, and the response curve can be accessed in another non-realtime thread
      * make sure there is at most one non-realtime thread accessing the response curve data
      * the maximum modulation rate of parameters is once per block
+     * all sections are processed in a fused cascade, tile by tile
+     * or, for long blocks, section by section in the block state-space form (not available for SVF)
+     * the sections sleep while both the input and the states are silent
      * @tparam FloatType
      */
     template<typename FloatType>
@@ -38,6 +43,33 @@ namespace zlIIR {
 
         void process(juce::AudioBuffer<FloatType> &buffer, bool isBypassed = false);
 
+        /**
+         * process the audio buffer while the coefficients move linearly from the current ones to the updated ones
+         * only the coefficients at the block end are designed, so it is cheap to modulate parameters every block
+         * @param buffer
+         * @param isBypassed
+         */
+        void processRamp(juce::AudioBuffer<FloatType> &buffer, bool isBypassed = false);
+
+        /**
+         * process the input block into the output block (out of place), section by section
+         * the first section reads the input and writes the output, hence the input is never copied
+         * it suits filters with a few sections, e.g. the side-chain filter writing into a scratch region
+         * @param inputBlock
+         * @param outputBlock it should have the same size as the input block
+         * @param isBypassed
+         */
+        void processTo(juce::dsp::AudioBlock<const FloatType> inputBlock, juce::dsp::AudioBlock<FloatType> outputBlock,
+                       bool isBypassed = false);
+
+        /**
+         * reset and update the filter for a block whose sections are processed outside (e.g. in a cascade)
+         * DO NOT call it together with process in the same block
+         * @param isBypassed
+         * @return whether the sections should be bypassed in this block
+         */
+        bool prepareBlock(bool isBypassed = false);
+
         /**
          * set the frequency of the filter
          * if frequency changes >= 2 octaves, the filter will reset
@@ -104,6 +136,13 @@ namespace zlIIR {
          */
         size_t getFilterNum() const { return filterNum.load(); }
 
+        /**
+         * get the coefficients of 2nd order filters
+         * DO NOT call it outside the real-time thread
+         * @return
+         */
+        const std::array<coeff33, 16> &getCoeffs() const { return coeffs; }
+
         /**
          * add response curve (dB) of this filter (multiplied by the scale) to an input array
          * @param x input array
@@ -137,6 +176,18 @@ namespace zlIIR {
         */
         inline std::array<double, frequencies.size()> &getGains() { return gains; }
 
+        /**
+         * multiply the complex response (magnitude, phase and group delay) of the current coefficients into response
+         * @param response
+         */
+        void multiplyResponses(ResponseEngine::ComplexResponse &response);
+
+        /**
+         * get the version of the current coefficients, it increases whenever they are updated
+         * @return
+         */
+        size_t getCoeffVersion() const { return coeffSnapshot.getVersion(); }
+
         /**
          * get the num of channels
          * @return
@@ -154,6 +205,24 @@ namespace zlIIR {
          */
         std::array<IIRBase<FloatType>, 16> &getFilters() { return filters; }
 
+        /**
+         * get the array of 2nd order state variable filters
+         * @return
+         */
+        std::array<SVFBase<FloatType>, 16> &getSVFFilters() { return svfFilters; }
+
+        /**
+         * get whether the state variable filters are used in the current block
+         * @return
+         */
+        inline bool getCurrentSVFON() const { return currentUseSVF; }
+
+        /**
+         * get whether the parameters have changed since the coefficients were updated
+         * @return
+         */
+        inline bool getParaOutdated() const { return toUpdatePara.load(); }
+
         /**
          * get whether the response curve is outdated
          * @return
@@ -175,6 +244,120 @@ namespace zlIIR {
 
         void setSVFON(const bool f) { useSVF.store(f); }
 
+        /**
+         * set whether to process TDF-II sections in the block state-space form
+         * it is more efficient for long blocks (e.g. offline rendering), SVF sections ignore it
+         * @param f
+         */
+        void setBlockSSON(const bool f) { useBlockSS.store(f); }
+
+        /**
+         * set whether to draw the response curve from the analog prototypes in closed form (see AnalogFunc)
+         * it only takes effect where the prototypes match the designed filter (see ResponseEngine::isAnalogMatched),
+         * otherwise the curve is still evaluated from the coefficients
+         * @param f
+         */
+        void setAnalogCurveON(const bool f) {
+            if (useAnalogCurve.exchange(f) != f) {
+                magOutdated.store(true);
+            }
+        }
+
+        /**
+         * set whether to design the coefficients with the approximated transcendental functions (see FastMath)
+         * it is meant for modulated filters, whose coefficients are redesigned on every (sub) block
+         * @param f
+         */
+        void setFastMathON(const bool f) {
+            if (useFastMath.exchange(f) != f) {
+                toUpdatePara.store(true);
+            }
+        }
+
+        /**
+         * set the coefficient cache, which is shared by the filters processed on the same real-time thread
+         * if it is set, the parameters are quantized before the design (see CoeffCache)
+         * @param cache
+         */
+        void setCoeffCache(CoeffCache *cache) { coeffCache = cache; }
+
+        /**
+         * get the parameters of the pending coefficient update, it does not consume the update
+         * @param spec
+         * @return whether an update is pending
+         */
+        bool getPendingSpec(DesignSpec &spec) const {
+            if (!toUpdatePara.load()) { return false; }
+            spec = {
+                filterType.load(), freq.load(), processSpec.sampleRate, gain.load(), q.load(), order.load(),
+                useFastMath.load()
+            };
+            return true;
+        }
+
+        /**
+         * check whether the peak of the buffer is below idleThreshold
+         * @param buffer
+         * @return
+         */
+        static bool isSilent(const juce::AudioBuffer<FloatType> &buffer) {
+            return buffer.getMagnitude(0, buffer.getNumSamples()) < idleThreshold;
+        }
+
+        static bool isSilent(const juce::dsp::AudioBlock<const FloatType> &block) {
+            const auto range = block.findMinAndMax();
+            return std::max(-range.getStart(), range.getEnd()) < idleThreshold;
+        }
+
+        /**
+         * check whether the filter is idle and can skip the block, call it before processing the sections
+         * an idle filter wakes up (with zero states) once the input is not silent
+         * @param isInputSilent whether the input of the block is silent
+         * @return whether the sections should skip the block
+         */
+        bool skipIdle(bool isInputSilent);
+
+        /**
+         * put the filter to idle if both the input and the states are silent, call it after processing the sections
+         * the states are zeroed so that the filter resumes exactly from rest
+         * @param isInputSilent whether the input of the block is silent
+         */
+        void updateIdle(bool isInputSilent);
+
+        /**
+         * check whether the peak of the section states is below idleThreshold
+         * @return
+         */
+        bool isStateSilent() const;
+
+        /**
+         * check whether the input silence matters in this block, i.e. the filter may wake up or go idle
+         * the states of a filter with non-silent input are rarely silent, so the common path skips the input pass
+         * @return
+         */
+        bool needsInputCheck() const { return isIdle || isStateSilent(); }
+
+        bool getIsIdle() const { return isIdle; }
+
+        /**
+         * get the number of blocks skipped since the filter is idle
+         * @return
+         */
+        size_t getIdleBlocks() const { return idleBlocks.load(); }
+
+        /**
+         * get the time for the impulse response to decay below idleThreshold
+         * it is estimated from the largest pole radius of the current coefficients
+         * @return
+         */
+        double getTailSeconds() const { return tailSeconds.load(); }
+
+        /** the peak (-140 dB) below which the input and the states are regarded as silence */
+        static constexpr FloatType idleThreshold = FloatType(1e-7);
+
+        /** the tail of (nearly) unstable filters */
+        static constexpr double maxTailSeconds = 30.0;
+
     private:
         std::array<IIRBase<FloatType>, 16> filters{};
 
@@ -188,16 +371,93 @@ namespace zlIIR {
 
         std::array<double, frequencies.size()> dBs{}, gains{};
         std::atomic<bool> magOutdated = false;
+        std::atomic<bool> useAnalogCurve{false};
+        /** the analog prototypes of the current response curve, only accessed on the non-realtime thread */
+        bool currentAnalogCurve{false};
+        size_t analogNum{0};
+        std::array<coeff33, 16> analogCoeffs{};
 
         std::atomic<bool> toUpdatePara = false, toReset = false;
 
         std::array<coeff33, 16> coeffs;
-        farbot::RealtimeObject<std::array<coeff33, 16>, farbot::RealtimeObjectOptions::realtimeMutatable> recentCoeffs;
+        /** the coefficients published for the response curves */
+        CoeffSnapshot coeffSnapshot;
 
         std::atomic<bool> useSVF{false};
         bool currentUseSVF{false};
         std::array<SVFBase<FloatType>, 16> svfFilters{};
         std::atomic<bool> bypassNextBlock{false};
+        std::atomic<bool> useBlockSS{false};
+        std::atomic<bool> useFastMath{false};
+
+        /** whether the filter is idle, only accessed on the real-time thread */
+        bool isIdle{false};
+        std::atomic<size_t> idleBlocks{0};
+        std::atomic<double> tailSeconds{0};
+        CoeffCache *coeffCache{nullptr};
+
+        alignas(Lanes<FloatType>::alignment) typename Lanes<FloatType>::Tile tile{};
+
+        /**
+         * shapes with specialized scalar kernels, they are used where the SIMD lane tile is not available,
+         * other shapes fall back to the generic cascade
+         */
+        static constexpr std::array<size_t, 3> fixedChannels{1, 2, 4};
+        static constexpr std::array<size_t, 5> fixedSections{1, 2, 4, 8, 16};
+        static constexpr size_t kernelNum = fixedChannels.size() * fixedSections.size();
+        static constexpr size_t invalidIdx = kernelNum;
+
+        template<typename BaseType>
+        using Kernel = void (Filter::*)(std::array<BaseType, 16> &, juce::dsp::AudioBlock<FloatType>, bool);
+
+        /** index of the current section count in fixedSections, only accessed on the real-time thread */
+        size_t sectionIdx{invalidIdx};
+
+        alignas(Lanes<FloatType>::alignment) std::array<FloatType, Lanes<FloatType>::tileSize * fixedChannels.back()> frames{};
+
+        /**
+         * process all sections in a fused cascade, so that the block is read and written once
+         * instead of once per section
+         */
+        template<typename BaseType>
+        void processCascade(std::array<BaseType, 16> &bases, juce::dsp::AudioBlock<FloatType> block, bool isBypassed);
+
+        /**
+         * the fused cascade with compile-time channel and section counts
+         */
+        template<typename BaseType, size_t NumChannels, size_t NumSections>
+        void processFixed(std::array<BaseType, 16> &bases, juce::dsp::AudioBlock<FloatType> block, bool isBypassed);
+
+        template<typename BaseType, size_t NumChannels, size_t NumSections, bool isBypassed>
+        void processFixedFrames(std::array<BaseType, 16> &bases, juce::dsp::AudioBlock<FloatType> block);
+
+        /**
+         * dispatch table of the specialized kernels, kernel (c, s) is stored at [c * fixedSections.size() + s]
+         */
+        template<typename BaseType>
+        static const std::array<Kernel<BaseType>, kernelNum> &getKernels();
+
+        template<typename BaseType, size_t... I>
+        static constexpr std::array<Kernel<BaseType>, kernelNum> makeKernels(std::index_sequence<I...>) {
+            return {
+                &Filter::processFixed<BaseType,
+                    fixedChannels[I / fixedSections.size()],
+                    fixedSections[I % fixedSections.size()]>...
+            };
+        }
+
+        template<typename BaseType>
+        void processRampSections(std::array<BaseType, 16> &bases,
+                                 const juce::dsp::AudioBlock<FloatType> &block, bool isBypassed);
+
+        /**
+         * load the designed coefficients into the sections
+         */
+        void loadCoeffs();
+
+        void updateSectionIdx();
+
+        void updateTail();
     };
 }
 
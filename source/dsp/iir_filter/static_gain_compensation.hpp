@@ -31,6 +31,11 @@ namespace zlIIR {
             if (f) toUpdate.store(true);
         }
 
+        /**
+         * @return the compensation gain (dB) set by the last update
+         */
+        FloatType getGainDecibels() const { return gain.getGainDecibels(); }
+
     private:
         Filter<FloatType> &target;
         juce::dsp::Gain<FloatType> gain;
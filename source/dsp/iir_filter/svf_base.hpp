@@ -11,16 +11,24 @@
 #define SVF_BASE_HPP
 
 #include "coeff/design_filter.hpp"
+#include "simd_lanes.hpp"
 
 namespace zlIIR {
+    /**
+     * a 2nd order state variable filter
+     * stereo (and up to SIMD-width) blocks are processed with one channel per SIMD lane
+     * the lane kernel performs the same operations in the same order as processSample,
+     * so it matches the scalar path up to floating-point contraction (< 1e-12 for double, < 1e-6 for float)
+     * @tparam SampleType
+     */
     template<typename SampleType>
     class SVFBase {
     public:
         SVFBase() = default;
 
         void prepare(const juce::dsp::ProcessSpec &spec) {
-            s1.resize(spec.numChannels);
-            s2.resize(spec.numChannels);
+            jassert(spec.numChannels <= Lanes<SampleType>::maxChannels);
+            juce::ignoreUnused(spec);
             reset();
         }
 
@@ -37,6 +45,18 @@ namespace zlIIR {
             }
         }
 
+        /**
+         * get the maximum magnitude of the states of all channels
+         * @return
+         */
+        SampleType getStatePeak() const {
+            SampleType peak{0};
+            for (size_t i = 0; i < s1.size(); ++i) {
+                peak = std::max(peak, std::max(std::abs(s1[i]), std::abs(s2[i])));
+            }
+            return peak;
+        }
+
         template<typename ProcessContext>
         void process(const ProcessContext &context) noexcept {
             const auto &inputBlock = context.getInputBlock();
@@ -48,7 +68,13 @@ namespace zlIIR {
             jassert(inputBlock.getNumChannels() == numChannels);
             jassert(inputBlock.getNumSamples() == numSamples);
 
-            if (context.isBypassed) {
+            if (Lanes<SampleType>::isAvailable(numChannels)) {
+                if (context.isBypassed) {
+                    processLanes<true>(inputBlock, outputBlock);
+                } else {
+                    processLanes<false>(inputBlock, outputBlock);
+                }
+            } else if (context.isBypassed) {
                 for (size_t channel = 0; channel < numChannels; ++channel) {
                     auto *inputSamples = inputBlock.getChannelPointer(channel);
                     auto *outputSamples = outputBlock.getChannelPointer(channel);
@@ -109,9 +135,143 @@ namespace zlIIR {
             clp = static_cast<SampleType>((b[0] + b[1] + b[2]) / (a[0] + a[1] + a[2]));
         }
 
+        /**
+         * process a lane-interleaved tile in place, the state stays in registers during the tile
+         * @tparam isBypassed whether the output is discarded (the state is still updated)
+         * @param tile numSamples x Lanes<SampleType>::size samples, aligned to Lanes<SampleType>::alignment
+         * @param numSamples
+         */
+        template<bool isBypassed>
+        void processTile(SampleType *tile, const size_t numSamples) noexcept {
+#if JUCE_USE_SIMD
+            using Register = typename Lanes<SampleType>::Register;
+            const auto vg = Register::expand(g), vgR2 = Register::expand(g + R2), vh = Register::expand(h);
+            const auto vhp = Register::expand(isBypassed ? SampleType(1) : chp);
+            const auto vbp = Register::expand(isBypassed ? -R2 : cbp);
+            const auto vlp = Register::expand(isBypassed ? SampleType(1) : clp);
+            auto r1 = Register::fromRawArray(s1.data());
+            auto r2 = Register::fromRawArray(s2.data());
+            for (size_t i = 0; i < numSamples; ++i) {
+                auto *x = tile + i * Lanes<SampleType>::size;
+                const auto inputValue = Register::fromRawArray(x);
+                const auto yHP = vh * (inputValue - r1 * vgR2 - r2);
+
+                const auto yBP = yHP * vg + r1;
+                r1 = yHP * vg + yBP;
+
+                const auto yLP = yBP * vg + r2;
+                r2 = yBP * vg + yLP;
+
+                const auto outputValue = vhp * yHP + vbp * yBP + vlp * yLP;
+                outputValue.copyToRawArray(x);
+            }
+            r1.copyToRawArray(s1.data());
+            r2.copyToRawArray(s2.data());
+#else
+            juce::ignoreUnused(tile, numSamples);
+#endif
+        }
+
+        /**
+         * process channel-interleaved frames in place, with a compile-time channel count
+         * the state is kept in local arrays, so the channel loop is unrolled (and vectorized) by the compiler
+         * @tparam NumChannels
+         * @tparam isBypassed whether to output the bypass sum instead of the filtered signal
+         * @param frames numSamples x NumChannels samples, sample i of channel c is stored at [i * NumChannels + c]
+         * @param numSamples
+         */
+        template<size_t NumChannels, bool isBypassed>
+        void processFrames(SampleType *frames, const size_t numSamples) noexcept {
+            static_assert(NumChannels <= Lanes<SampleType>::maxChannels);
+            const auto gR2 = g + R2;
+            const auto vhp = isBypassed ? SampleType(1) : chp;
+            const auto vbp = isBypassed ? -R2 : cbp;
+            const auto vlp = isBypassed ? SampleType(1) : clp;
+            std::array<SampleType, NumChannels> r1, r2;
+            std::copy_n(s1.begin(), NumChannels, r1.begin());
+            std::copy_n(s2.begin(), NumChannels, r2.begin());
+            for (size_t i = 0; i < numSamples; ++i) {
+                auto *x = frames + i * NumChannels;
+                for (size_t channel = 0; channel < NumChannels; ++channel) {
+                    const auto yHP = h * (x[channel] - r1[channel] * gR2 - r2[channel]);
+
+                    const auto yBP = yHP * g + r1[channel];
+                    r1[channel] = yHP * g + yBP;
+
+                    const auto yLP = yBP * g + r2[channel];
+                    r2[channel] = yBP * g + yLP;
+
+                    x[channel] = vhp * yHP + vbp * yBP + vlp * yLP;
+                }
+            }
+            std::copy_n(r1.begin(), NumChannels, s1.begin());
+            std::copy_n(r2.begin(), NumChannels, s2.begin());
+        }
+
+        /**
+         * process a block in place while g, R2 and the mix coefficients move linearly to those of a biquad
+         * the target is reached at the last sample, and it is kept as the coefficients afterward
+         * g and R2 stay positive during the ramp, so every intermediate section is stable
+         * @tparam isBypassed whether to output the bypass sum instead of the filtered signal
+         * @param block
+         * @param target
+         */
+        template<bool isBypassed>
+        void processRamp(const juce::dsp::AudioBlock<SampleType> &block, const coeff33 &target) noexcept {
+            const std::array<SampleType, 5> start{g, R2, chp, cbp, clp};
+            updateFromBiquad(target);
+            const auto numSamples = block.getNumSamples();
+            if (numSamples == 0) { return; }
+            const auto scale = SampleType(1) / static_cast<SampleType>(numSamples);
+            const std::array<SampleType, 5> delta{
+                (g - start[0]) * scale, (R2 - start[1]) * scale,
+                (chp - start[2]) * scale, (cbp - start[3]) * scale, (clp - start[4]) * scale
+            };
+            for (size_t channel = 0; channel < block.getNumChannels(); ++channel) {
+                auto *samples = block.getChannelPointer(channel);
+                auto vg = start[0], vR2 = start[1], vhp = start[2], vbp = start[3], vlp = start[4];
+                auto r1 = s1[channel], r2 = s2[channel];
+                for (size_t i = 0; i < numSamples; ++i) {
+                    vg += delta[0];
+                    vR2 += delta[1];
+                    vhp += delta[2];
+                    vbp += delta[3];
+                    vlp += delta[4];
+                    const auto vh = SampleType(1) / (vg * (vR2 + vg) + SampleType(1));
+                    const auto yHP = vh * (samples[i] - r1 * (vg + vR2) - r2);
+
+                    const auto yBP = yHP * vg + r1;
+                    r1 = yHP * vg + yBP;
+
+                    const auto yLP = yBP * vg + r2;
+                    r2 = yBP * vg + yLP;
+
+                    if constexpr (isBypassed) {
+                        samples[i] = yHP - vR2 * yBP + yLP;
+                    } else {
+                        samples[i] = vhp * yHP + vbp * yBP + vlp * yLP;
+                    }
+                }
+                s1[channel] = r1;
+                s2[channel] = r2;
+            }
+        }
+
     private:
         SampleType g, R2, h, chp, cbp, clp;
-        std::vector<SampleType> s1, s2;
+        alignas(Lanes<SampleType>::alignment) typename Lanes<SampleType>::Array s1{}, s2{};
+
+        template<bool isBypassed, typename InputBlockType, typename OutputBlockType>
+        void processLanes(const InputBlockType &inputBlock, const OutputBlockType &outputBlock) noexcept {
+            const auto numSamples = outputBlock.getNumSamples();
+            alignas(Lanes<SampleType>::alignment) typename Lanes<SampleType>::Tile tile{};
+            for (size_t start = 0; start < numSamples; start += Lanes<SampleType>::tileSize) {
+                const auto n = std::min(Lanes<SampleType>::tileSize, numSamples - start);
+                Lanes<SampleType>::toTile(inputBlock, start, n, tile.data());
+                processTile<isBypassed>(tile.data(), n);
+                Lanes<SampleType>::fromTile(tile.data(), start, n, outputBlock);
+            }
+        }
     };
 }
 
@@ -0,0 +1,82 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include "compiled_preset.hpp"
+
+#include <iomanip>
+#include <limits>
+#include <string>
+
+namespace zlPreset {
+    void CompiledPreset::append(const Route route, const Section &section) {
+        sections.push_back(section);
+        for (auto j = static_cast<size_t>(route) + 1; j < offsets.size(); ++j) {
+            offsets[j] = sections.size();
+        }
+    }
+
+    void CompiledPreset::clear() {
+        sampleRate = 48000;
+        effectON = true;
+        outputGain = 1;
+        offsets.fill(0);
+        sections.clear();
+    }
+
+    void CompiledPreset::write(std::ostream &stream) const {
+        const auto flags = stream.flags();
+        const auto precision = stream.precision(std::numeric_limits<double>::max_digits10);
+        stream << formatTag << " " << formatVersion << "\n";
+        stream << "sample_rate " << sampleRate << "\n";
+        stream << "effect_on " << (effectON ? 1 : 0) << "\n";
+        stream << "output_gain " << outputGain << "\n";
+        for (size_t j = 0; j < routeNum; ++j) {
+            const auto route = static_cast<Route>(j);
+            stream << "route " << j << " " << getNumSections(route) << "\n";
+            const auto *s = getSections(route);
+            for (size_t i = 0; i < getNumSections(route); ++i) {
+                stream << s[i].b0 << " " << s[i].b1 << " " << s[i].b2 << " " << s[i].a1 << " " << s[i].a2 << "\n";
+            }
+        }
+        stream.precision(precision);
+        stream.flags(flags);
+    }
+
+    bool CompiledPreset::read(std::istream &stream) {
+        clear();
+        std::string tag;
+        int version = 0, isON = 0;
+        if (!(stream >> tag >> version) || tag != formatTag || version != formatVersion) {
+            return false;
+        }
+        if (!(stream >> tag >> sampleRate) || tag != "sample_rate" ||
+            !(stream >> tag >> isON) || tag != "effect_on" ||
+            !(stream >> tag >> outputGain) || tag != "output_gain") {
+            clear();
+            return false;
+        }
+        effectON = isON != 0;
+        for (size_t j = 0; j < routeNum; ++j) {
+            size_t idx = 0, num = 0;
+            if (!(stream >> tag >> idx >> num) || tag != "route" || idx != j) {
+                clear();
+                return false;
+            }
+            for (size_t i = 0; i < num; ++i) {
+                Section s;
+                if (!(stream >> s.b0 >> s.b1 >> s.b2 >> s.a1 >> s.a2)) {
+                    clear();
+                    return false;
+                }
+                append(static_cast<Route>(j), s);
+            }
+        }
+        return true;
+    }
+}
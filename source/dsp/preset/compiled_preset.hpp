@@ -0,0 +1,78 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_COMPILED_PRESET_HPP
+#define ZLEQUALIZER_COMPILED_PRESET_HPP
+
+#include <array>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace zlPreset {
+    /**
+     * a plugin state flattened into fixed cascades of 2nd order sections, one cascade per channel route
+     * the sections of a route are the sections of its (non-bypassed) bands in the order of bands,
+     * normalized by a0 and stored as the TDF-II coefficients b0, b1, b2, a1, a2
+     * it only holds plain values, so that it can be stored, copied and shared by any number of runtimes
+     */
+    struct CompiledPreset {
+        /** the channel routes, in the same order as zlDSP::lrType */
+        enum Route { stereo, left, right, mid, side, routeNum };
+
+        struct Section {
+            double b0{1}, b1{0}, b2{0}, a1{0}, a2{0};
+        };
+
+        /** the sample rate which the sections are designed at */
+        double sampleRate{48000};
+        /** if false, the runtime passes the signal through untouched */
+        bool effectON{true};
+        /** the linear output gain */
+        double outputGain{1};
+        /** the sections of route j are sections[offsets[j]] ... sections[offsets[j + 1] - 1] */
+        std::array<size_t, routeNum + 1> offsets{};
+        std::vector<Section> sections;
+
+        size_t getNumSections(const Route route) const {
+            return offsets[static_cast<size_t>(route) + 1] - offsets[static_cast<size_t>(route)];
+        }
+
+        const Section *getSections(const Route route) const {
+            return sections.data() + offsets[static_cast<size_t>(route)];
+        }
+
+        /**
+         * append a section to the last route, routes must be appended in order
+         * @param route
+         * @param section
+         */
+        void append(Route route, const Section &section);
+
+        void clear();
+
+        /**
+         * write the preset as plain text, the values are written with enough digits to be read back exactly
+         * @param stream
+         */
+        void write(std::ostream &stream) const;
+
+        /**
+         * read a preset written by write
+         * @param stream
+         * @return whether the stream holds a valid preset, the preset is cleared if not
+         */
+        bool read(std::istream &stream);
+
+        static constexpr auto formatTag = "ZLEqualizerCompiledPreset";
+        static constexpr int formatVersion = 1;
+    };
+}
+
+#endif //ZLEQUALIZER_COMPILED_PRESET_HPP
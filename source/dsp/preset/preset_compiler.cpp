@@ -0,0 +1,76 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include "preset_compiler.hpp"
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+namespace zlPreset {
+    bool PresetCompiler::compile(const juce::XmlElement &state, const double sampleRate, CompiledPreset &preset) {
+        preset.clear();
+        const auto *parameters = state.hasTagName(parametersTag) ? &state : state.getChildByName(parametersTag);
+        if (parameters == nullptr || sampleRate <= 0) { return false; }
+
+        // the APVTS stores the un-normalized values, missing parameters keep their defaults
+        const auto getValue = [&](const std::string &ID, const double defaultV) {
+            const auto *param = parameters->getChildByAttribute("id", ID);
+            return param == nullptr ? defaultV : param->getDoubleAttribute("value", defaultV);
+        };
+        const auto getIndex = [&](const std::string &ID, const int defaultI) {
+            return static_cast<size_t>(std::max(juce::roundToInt(getValue(ID, defaultI)), 0));
+        };
+
+        preset.sampleRate = sampleRate;
+        preset.effectON = getIndex(zlDSP::effectON::ID, zlDSP::effectON::defaultI) != 0;
+        preset.outputGain = juce::Decibels::decibelsToGain(
+            getValue(zlDSP::outputGain::ID, zlDSP::outputGain::defaultV), -240.0);
+        const auto scale = zlDSP::scale::formatV(getValue(zlDSP::scale::ID, zlDSP::scale::defaultV));
+
+        std::array<std::vector<CompiledPreset::Section>, CompiledPreset::routeNum> routes;
+        std::array<zlIIR::coeff33, 16> coeffs{};
+        for (size_t i = 0; i < zlDSP::bandNUM; ++i) {
+            const auto suffix = zlDSP::appendSuffix("", i);
+            if (getValue(zlDSP::bypass::ID + suffix, zlDSP::bypass::defaultV ? 1.0 : 0.0) > 0.5) { continue; }
+            const auto route = std::min(getIndex(zlDSP::lrType::ID + suffix, zlDSP::lrType::defaultI),
+                                        static_cast<size_t>(CompiledPreset::routeNum) - 1);
+            const auto filterType = static_cast<zlIIR::FilterType>(
+                std::min(getIndex(zlDSP::fType::ID + suffix, zlDSP::fType::defaultI),
+                         static_cast<size_t>(zlDSP::fType::fTypeNUM) - 1));
+            const auto order = zlDSP::slope::orderArray[std::min(
+                getIndex(zlDSP::slope::ID + suffix, zlDSP::slope::defaultI), zlDSP::slope::orderArray.size() - 1)];
+            const auto freq = getValue(zlDSP::freq::ID + suffix, zlDSP::freq::defaultV);
+            const auto q = getValue(zlDSP::Q::ID + suffix, zlDSP::Q::defaultV);
+            const auto gain = zlDSP::gain::range.snapToLegalValue(
+                static_cast<float>(getValue(zlDSP::gain::ID + suffix, zlDSP::gain::defaultV) * scale));
+
+            const auto num = zlIIR::DesignFilter::updateCoeff(filterType, freq, sampleRate, gain, q, order, coeffs);
+            for (size_t k = 0; k < num; ++k) {
+                const auto &[a, b] = coeffs[k];
+                const auto a0Inv = 1.0 / a[0];
+                routes[route].push_back({b[0] * a0Inv, b[1] * a0Inv, b[2] * a0Inv, a[1] * a0Inv, a[2] * a0Inv});
+            }
+        }
+        for (size_t j = 0; j < CompiledPreset::routeNum; ++j) {
+            for (const auto &section: routes[j]) {
+                preset.append(static_cast<CompiledPreset::Route>(j), section);
+            }
+        }
+        return true;
+    }
+
+    bool PresetCompiler::compile(const void *data, const int sizeInBytes, const double sampleRate,
+                                 CompiledPreset &preset) {
+        const auto xml = juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes);
+        if (xml == nullptr || !xml->hasTagName(stateTag)) {
+            preset.clear();
+            return false;
+        }
+        return compile(*xml, sampleRate, preset);
+    }
+}
@@ -0,0 +1,51 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_PRESET_COMPILER_HPP
+#define ZLEQUALIZER_PRESET_COMPILER_HPP
+
+#include <juce_core/juce_core.h>
+
+#include "../dsp_definitions.hpp"
+#include "../iir_filter/iir_filter.hpp"
+#include "compiled_preset.hpp"
+
+namespace zlPreset {
+    /**
+     * compiles a plugin state (the xml written by getStateInformation) into a CompiledPreset
+     * each non-bypassed band is designed with its base parameters (gain scaled by scale) and its sections are
+     * appended to the route of its lr_type, dynamic bands are compiled as static ones
+     * the auto gain, the static gain compensation and the side-chain are not part of the compiled preset
+     */
+    class PresetCompiler {
+    public:
+        /**
+         * @param state the root element of the state (ZLEqualizerParaState) or its parameter element
+         * @param sampleRate the sample rate which the sections are designed at
+         * @param preset
+         * @return whether the xml holds the parameters of the plugin, the preset is cleared if not
+         */
+        static bool compile(const juce::XmlElement &state, double sampleRate, CompiledPreset &preset);
+
+        /**
+         * compile the binary state written by getStateInformation
+         * @param data
+         * @param sizeInBytes
+         * @param sampleRate
+         * @param preset
+         * @return
+         */
+        static bool compile(const void *data, int sizeInBytes, double sampleRate, CompiledPreset &preset);
+
+        static constexpr auto stateTag = "ZLEqualizerParaState";
+        static constexpr auto parametersTag = "ZLEqualizerParameters";
+    };
+}
+
+#endif //ZLEQUALIZER_PRESET_COMPILER_HPP
@@ -0,0 +1,92 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include "preset_runtime.hpp"
+
+#include <algorithm>
+
+namespace zlPreset {
+    template<typename FloatType>
+    PresetRuntime<FloatType>::PresetRuntime(const CompiledPreset &preset)
+        : presetRef(preset) {
+        size_t stateNum = 0;
+        for (size_t j = 0; j < CompiledPreset::routeNum; ++j) {
+            const auto route = static_cast<CompiledPreset::Route>(j);
+            stateOffsets[j] = stateNum;
+            stateNum += presetRef.getNumSections(route) * (route == CompiledPreset::stereo ? 4 : 2);
+        }
+        states.resize(stateNum);
+    }
+
+    template<typename FloatType>
+    void PresetRuntime<FloatType>::reset() {
+        std::fill(states.begin(), states.end(), FloatType(0));
+    }
+
+    template<typename FloatType>
+    void PresetRuntime<FloatType>::process(FloatType *lBuffer, FloatType *rBuffer, const size_t numSamples) {
+        if (!presetRef.effectON) { return; }
+        processRoute(CompiledPreset::stereo, 0, lBuffer, numSamples);
+        processRoute(CompiledPreset::stereo, 1, rBuffer, numSamples);
+        processRoute(CompiledPreset::left, 0, lBuffer, numSamples);
+        processRoute(CompiledPreset::right, 0, rBuffer, numSamples);
+        if (presetRef.getNumSections(CompiledPreset::mid) + presetRef.getNumSections(CompiledPreset::side) > 0) {
+            // split into mid/side in place
+            for (size_t i = 0; i < numSamples; ++i) {
+                const auto l = lBuffer[i], r = rBuffer[i];
+                lBuffer[i] = FloatType(0.5) * (l + r);
+                rBuffer[i] = FloatType(0.5) * (l - r);
+            }
+            processRoute(CompiledPreset::mid, 0, lBuffer, numSamples);
+            processRoute(CompiledPreset::side, 0, rBuffer, numSamples);
+            for (size_t i = 0; i < numSamples; ++i) {
+                const auto m = lBuffer[i], s = rBuffer[i];
+                lBuffer[i] = m + s;
+                rBuffer[i] = m - s;
+            }
+        }
+        if (presetRef.outputGain != 1) {
+            const auto g = static_cast<FloatType>(presetRef.outputGain);
+            for (size_t i = 0; i < numSamples; ++i) {
+                lBuffer[i] *= g;
+                rBuffer[i] *= g;
+            }
+        }
+    }
+
+    template<typename FloatType>
+    void PresetRuntime<FloatType>::processRoute(const CompiledPreset::Route route, const size_t channel,
+                                                FloatType *buffer, const size_t numSamples) {
+        const auto num = presetRef.getNumSections(route);
+        const auto *sections = presetRef.getSections(route);
+        auto *state = states.data() + stateOffsets[static_cast<size_t>(route)] + channel * num * 2;
+        // process section by section, so that the coefficients and the states stay in registers
+        for (size_t k = 0; k < num; ++k) {
+            const auto b0 = static_cast<FloatType>(sections[k].b0), b1 = static_cast<FloatType>(sections[k].b1);
+            const auto b2 = static_cast<FloatType>(sections[k].b2);
+            const auto a1 = static_cast<FloatType>(sections[k].a1), a2 = static_cast<FloatType>(sections[k].a2);
+            auto s1 = state[2 * k], s2 = state[2 * k + 1];
+            for (size_t i = 0; i < numSamples; ++i) {
+                const auto x = buffer[i];
+                const auto y = x * b0 + s1;
+                s1 = (x * b1) - (y * a1) + s2;
+                s2 = (x * b2) - (y * a2);
+                buffer[i] = y;
+            }
+            state[2 * k] = s1;
+            state[2 * k + 1] = s2;
+        }
+    }
+
+    template
+    class PresetRuntime<float>;
+
+    template
+    class PresetRuntime<double>;
+}
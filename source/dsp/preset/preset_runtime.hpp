@@ -0,0 +1,52 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEQUALIZER_PRESET_RUNTIME_HPP
+#define ZLEQUALIZER_PRESET_RUNTIME_HPP
+
+#include "compiled_preset.hpp"
+
+namespace zlPreset {
+    /**
+     * a minimal runtime that executes a compiled preset on a stereo stream
+     * it follows the routing of the plugin: the stereo route on both channels, then the left/right routes,
+     * then the mid/side routes on 0.5 * (L + R) and 0.5 * (L - R), and finally the output gain
+     * the preset is shared (it must outlive the runtime), the runtime itself only holds the section states
+     * which are allocated once in the constructor, process neither allocates nor locks
+     * denormals are not handled here, the caller should disable them (e.g. with juce::ScopedNoDenormals)
+     * @tparam FloatType
+     */
+    template<typename FloatType>
+    class PresetRuntime {
+    public:
+        explicit PresetRuntime(const CompiledPreset &preset);
+
+        void reset();
+
+        /**
+         * process a stereo block in place
+         * @param lBuffer left channel
+         * @param rBuffer right channel
+         * @param numSamples
+         */
+        void process(FloatType *lBuffer, FloatType *rBuffer, size_t numSamples);
+
+        inline const CompiledPreset &getPreset() const { return presetRef; }
+
+    private:
+        const CompiledPreset &presetRef;
+        /** the TDF-II states s1, s2 of each section on each channel, the stereo route has two channels */
+        std::vector<FloatType> states;
+        std::array<size_t, CompiledPreset::routeNum> stateOffsets{};
+
+        void processRoute(CompiledPreset::Route route, size_t channel, FloatType *buffer, size_t numSamples);
+    };
+}
+
+#endif //ZLEQUALIZER_PRESET_RUNTIME_HPP
@@ -10,10 +10,11 @@
 #include "button_panel.hpp"
 
 namespace zlPanel {
-    ButtonPanel::ButtonPanel(juce::AudioProcessorValueTreeState &parameters,
-                             juce::AudioProcessorValueTreeState &parametersNA,
-                             zlInterface::UIBase &base,
-                             zlDSP::Controller<double> &c)
+    template<typename FloatType>
+    ButtonPanel<FloatType>::ButtonPanel(juce::AudioProcessorValueTreeState &parameters,
+                                        juce::AudioProcessorValueTreeState &parametersNA,
+                                        zlInterface::UIBase &base,
+                                        zlDSP::Controller<FloatType> &c)
         : parametersRef(parameters), parametersNARef(parametersNA),
           uiBase(base), controllerRef(c),
           wheelSlider{
@@ -70,7 +71,8 @@ namespace zlPanel {
         itemsSet.addChangeListener(this);
     }
 
-    ButtonPanel::~ButtonPanel() {
+    template<typename FloatType>
+    ButtonPanel<FloatType>::~ButtonPanel() {
         for (const auto &idx: NAIDs) {
             parametersNARef.removeParameterListener(idx, this);
         }
@@ -86,7 +88,8 @@ namespace zlPanel {
         wheelAttachment[2].reset();
     }
 
-    void ButtonPanel::paint(juce::Graphics &g) {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::paint(juce::Graphics &g) {
         if (uiBase.getColourByIdx(zlInterface::tagColour).getFloatAlpha() < 0.01f) {
             return;
         }
@@ -106,8 +109,9 @@ namespace zlPanel {
         }
     }
 
-    void ButtonPanel::drawFilterParas(juce::Graphics &g, const zlIIR::Filter<double> &f,
-                                      const juce::Rectangle<float> &bound) {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::drawFilterParas(juce::Graphics &g, const zlIIR::Filter<FloatType> &f,
+                                                 const juce::Rectangle<float> &bound) {
         switch (f.getFilterType()) {
             case zlIIR::FilterType::peak:
             case zlIIR::FilterType::bandShelf: {
@@ -136,8 +140,9 @@ namespace zlPanel {
         drawFreq(g, static_cast<float>(f.getFreq()), bound, false);
     }
 
-    void ButtonPanel::drawFreq(juce::Graphics &g, const float freq, const juce::Rectangle<float> &bound,
-                               const bool isTop) {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::drawFreq(juce::Graphics &g, const float freq, const juce::Rectangle<float> &bound,
+                                          const bool isTop) {
         const auto freqString = freq < 100 ? juce::String(freq, 2, false) : juce::String(freq, 1, false);
         juce::ignoreUnused(isTop);
         auto p = std::log(freq / 10.f) / std::log(2205.f);
@@ -151,8 +156,9 @@ namespace zlPanel {
         g.drawText(freqString, textBound, juce::Justification::centredBottom, false);
     }
 
-    void ButtonPanel::drawGain(juce::Graphics &g, const float gain, const juce::Rectangle<float> &bound,
-                               const bool isLeft) {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::drawGain(juce::Graphics &g, const float gain, const juce::Rectangle<float> &bound,
+                                          const bool isLeft) {
         const auto tempBound = bound.withSizeKeepingCentre(bound.getWidth(), bound.getHeight() - 2 * uiBase.getFontSize());
         const auto gString = std::abs(gain) < 10 ? juce::String(gain, 2, false) : juce::String(gain, 1, false);
         const auto p = juce::jlimit(-0.5f, 0.5f, -.5f * gain / maximumDB.load());
@@ -175,7 +181,8 @@ namespace zlPanel {
         g.drawText(gString, textBound, juce::Justification::centred, false);
     }
 
-    void ButtonPanel::resized() {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::resized() {
         for (const auto &p: panels) {
             p->setBounds(getLocalBounds());
         }
@@ -184,7 +191,8 @@ namespace zlPanel {
         }
     }
 
-    void ButtonPanel::mouseDown(const juce::MouseEvent &event) {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::mouseDown(const juce::MouseEvent &event) {
         if (event.originalComponent != this) {
             isLeftClick.store(!event.mods.isRightButtonDown());
             for (size_t idx = 0; idx < panels.size(); ++idx) {
@@ -206,21 +214,24 @@ namespace zlPanel {
         lassoComponent.beginLasso(event, this);
     }
 
-    void ButtonPanel::mouseUp(const juce::MouseEvent &event) {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::mouseUp(const juce::MouseEvent &event) {
         if (event.originalComponent != this) {
             return;
         }
         lassoComponent.endLasso();
     }
 
-    void ButtonPanel::mouseDrag(const juce::MouseEvent &event) {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::mouseDrag(const juce::MouseEvent &event) {
         if (event.originalComponent != this) {
             return;
         }
         lassoComponent.dragLasso(event);
     }
 
-    void ButtonPanel::mouseWheelMove(const juce::MouseEvent &event, const juce::MouseWheelDetails &wheel) {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::mouseWheelMove(const juce::MouseEvent &event, const juce::MouseWheelDetails &wheel) {
         juce::MouseEvent e{
             event.source, event.position,
             event.mods.withoutMouseButtons(),
@@ -248,7 +259,8 @@ namespace zlPanel {
         }
     }
 
-    void ButtonPanel::mouseDoubleClick(const juce::MouseEvent &event) {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::mouseDoubleClick(const juce::MouseEvent &event) {
         if (event.originalComponent != this) {
             return;
         }
@@ -320,7 +332,8 @@ namespace zlPanel {
         }
     }
 
-    void ButtonPanel::parameterChanged(const juce::String &parameterID, float newValue) {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::parameterChanged(const juce::String &parameterID, float newValue) {
         if (parameterID == zlState::selectedBandIdx::ID) {
             const auto idx = static_cast<size_t>(newValue);
             selectBandIdx.store(idx);
@@ -396,7 +409,8 @@ namespace zlPanel {
         }
     }
 
-    void ButtonPanel::attachGroup(const size_t idx) {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::attachGroup(const size_t idx) {
         for (size_t oldIdx = 0; oldIdx < zlState::bandNUM; ++oldIdx) {
             for (const auto &parameter: IDs) {
                 parametersRef.removeParameterListener(zlDSP::appendSuffix(parameter, oldIdx), this);
@@ -411,7 +425,8 @@ namespace zlPanel {
             static_cast<double>(parametersRef.getRawParameterValue(zlDSP::appendSuffix(zlDSP::Q::ID, idx))->load()));
     }
 
-    void ButtonPanel::handleAsyncUpdate() {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::handleAsyncUpdate() {
         if (toAttachGroup.exchange(false)) {
             const auto idx = selectBandIdx.load();
             attachGroup(idx);
@@ -434,7 +449,8 @@ namespace zlPanel {
         repaint();
     }
 
-    size_t ButtonPanel::findAvailableBand() const {
+    template<typename FloatType>
+    size_t ButtonPanel<FloatType>::findAvailableBand() const {
         for (size_t i = 0; i < zlState::bandNUM; ++i) {
             const auto idx = zlState::appendSuffix(zlState::active::ID, i);
             const auto isActive = static_cast<bool>(parametersNARef.getRawParameterValue(idx)->load());
@@ -443,7 +459,8 @@ namespace zlPanel {
         return zlState::bandNUM;
     }
 
-    void ButtonPanel::findLassoItemsInArea(juce::Array<size_t> &itemsFound, const juce::Rectangle<int> &area) {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::findLassoItemsInArea(juce::Array<size_t> &itemsFound, const juce::Rectangle<int> &area) {
         juce::ignoreUnused(itemsFound, area);
         for (size_t idx = 0; idx < panels.size(); ++idx) {
             if (static_cast<bool>(parametersNARef.getRawParameterValue(
@@ -458,11 +475,13 @@ namespace zlPanel {
         }
     }
 
-    juce::SelectedItemSet<size_t> &ButtonPanel::getLassoSelection() {
+    template<typename FloatType>
+    juce::SelectedItemSet<size_t> &ButtonPanel<FloatType>::getLassoSelection() {
         return itemsSet;
     }
 
-    void ButtonPanel::changeListenerCallback(juce::ChangeBroadcaster *source) {
+    template<typename FloatType>
+    void ButtonPanel<FloatType>::changeListenerCallback(juce::ChangeBroadcaster *source) {
         juce::ignoreUnused(source);
         for (size_t idx = 0; idx < panels.size(); ++idx) {
             const auto f1 = itemsSet.isSelected(idx);
@@ -474,4 +493,10 @@ namespace zlPanel {
             }
         }
     }
+
+    template
+    class ButtonPanel<float>;
+
+    template
+    class ButtonPanel<double>;
 } // zlPanel
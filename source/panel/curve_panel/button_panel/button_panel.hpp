@@ -16,6 +16,7 @@
 #include "../../../state/state.hpp"
 
 namespace zlPanel {
+    template<typename FloatType>
     class ButtonPanel final : public juce::Component,
                               private juce::LassoSource<size_t>,
                               private juce::AudioProcessorValueTreeState::Listener,
@@ -25,7 +26,7 @@ namespace zlPanel {
         explicit ButtonPanel(juce::AudioProcessorValueTreeState &parameters,
                              juce::AudioProcessorValueTreeState &parametersNA,
                              zlInterface::UIBase &base,
-                             zlDSP::Controller<double> &c);
+                             zlDSP::Controller<FloatType> &c);
 
         ~ButtonPanel() override;
 
@@ -58,7 +59,7 @@ namespace zlPanel {
 
         juce::AudioProcessorValueTreeState &parametersRef, &parametersNARef;
         zlInterface::UIBase &uiBase;
-        zlDSP::Controller<double> &controllerRef;
+        zlDSP::Controller<FloatType> &controllerRef;
 
         std::array<zlInterface::SnappingSlider, 3> wheelSlider;
         std::array<std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment>, 3> wheelAttachment;
@@ -104,7 +105,7 @@ namespace zlPanel {
 
         void attachGroup(size_t idx);
 
-        inline void drawFilterParas(juce::Graphics &g, const zlIIR::Filter<double> &f, const juce::Rectangle<float> &bound);
+        inline void drawFilterParas(juce::Graphics &g, const zlIIR::Filter<FloatType> &f, const juce::Rectangle<float> &bound);
 
         inline void drawFreq(juce::Graphics &g, float freq, const juce::Rectangle<float> &bound, bool isTop);
 
@@ -10,25 +10,35 @@
 #include "conflict_panel.hpp"
 
 namespace zlPanel {
-    ConflictPanel::ConflictPanel(zlFFT::ConflictAnalyzer<double> &conflictAnalyzer, zlInterface::UIBase &base)
+    template<typename FloatType>
+    ConflictPanel<FloatType>::ConflictPanel(zlFFT::ConflictAnalyzer<FloatType> &conflictAnalyzer, zlInterface::UIBase &base)
         : analyzer(conflictAnalyzer), uiBase(base) {
         analyzer.start();
         setInterceptsMouseClicks(false, false);
         juce::ignoreUnused(uiBase);
     }
 
-    ConflictPanel::~ConflictPanel() {
+    template<typename FloatType>
+    ConflictPanel<FloatType>::~ConflictPanel() {
         analyzer.stop();
     }
 
-    void ConflictPanel::paint(juce::Graphics &g) {
+    template<typename FloatType>
+    void ConflictPanel<FloatType>::paint(juce::Graphics &g) {
         if (isGradientInit.load()) {
             g.setGradientFill(gradient);
             g.fillRect(getLocalBounds());
         }
     }
 
-    void ConflictPanel::resized() {
+    template<typename FloatType>
+    void ConflictPanel<FloatType>::resized() {
         analyzer.setLeftRight(0.f, static_cast<float>(getRight()));
     }
+
+    template
+    class ConflictPanel<float>;
+
+    template
+    class ConflictPanel<double>;
 } // zlPanel
@@ -16,9 +16,10 @@
 #include "../../../gui/gui.hpp"
 
 namespace zlPanel {
+    template<typename FloatType>
     class ConflictPanel final : public juce::Component {
     public:
-        explicit ConflictPanel(zlFFT::ConflictAnalyzer<double> &conflictAnalyzer,
+        explicit ConflictPanel(zlFFT::ConflictAnalyzer<FloatType> &conflictAnalyzer,
                                zlInterface::UIBase &base);
 
         ~ConflictPanel() override;
@@ -37,7 +38,7 @@ namespace zlPanel {
         }
 
     private:
-        zlFFT::ConflictAnalyzer<double> &analyzer;
+        zlFFT::ConflictAnalyzer<FloatType> &analyzer;
         zlInterface::UIBase &uiBase;
         juce::Path path;
         juce::ColourGradient gradient;
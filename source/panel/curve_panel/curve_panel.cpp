@@ -10,10 +10,11 @@
 #include "curve_panel.hpp"
 
 namespace zlPanel {
-    CurvePanel::CurvePanel(juce::AudioProcessorValueTreeState &parameters,
-                           juce::AudioProcessorValueTreeState &parametersNA,
-                           zlInterface::UIBase &base,
-                           zlDSP::Controller<double> &c)
+    template<typename FloatType>
+    CurvePanel<FloatType>::CurvePanel(juce::AudioProcessorValueTreeState &parameters,
+                                      juce::AudioProcessorValueTreeState &parametersNA,
+                                      zlInterface::UIBase &base,
+                                      zlDSP::Controller<FloatType> &c)
         : Thread("curve panel"),
           parametersNARef(parametersNA), uiBase(base),
           controllerRef(c),
@@ -21,6 +22,7 @@ namespace zlPanel {
           fftPanel(c.getAnalyzer(), base),
           conflictPanel(c.getConflictAnalyzer(), base),
           sumPanel(parameters, base, c),
+          phasePanel(parameters, base, c),
           soloPanel(parameters, parametersNA, base, c),
           buttonPanel(parameters, parametersNA, base, c),
           currentT(juce::Time::getCurrentTime()),
@@ -30,34 +32,42 @@ namespace zlPanel {
         addAndMakeVisible(conflictPanel);
         for (size_t i = 0; i < zlState::bandNUM; ++i) {
             singlePanels[i] = std::make_unique<
-                SinglePanel>(zlState::bandNUM - i - 1, parameters, parametersNA, base, c);
+                SinglePanel<FloatType>>(zlState::bandNUM - i - 1, parameters, parametersNA, base, c);
             addAndMakeVisible(*singlePanels[i]);
         }
         addAndMakeVisible(sumPanel);
+        addAndMakeVisible(phasePanel);
         addAndMakeVisible(soloPanel);
         addAndMakeVisible(buttonPanel);
         parameterChanged(zlState::maximumDB::ID, parametersNA.getRawParameterValue(zlState::maximumDB::ID)->load());
         parametersNARef.addParameterListener(zlState::maximumDB::ID, this);
+        parameterChanged(zlState::phaseView::ID, parametersNA.getRawParameterValue(zlState::phaseView::ID)->load());
+        parametersNARef.addParameterListener(zlState::phaseView::ID, this);
         startThread(juce::Thread::Priority::low);
     }
 
-    CurvePanel::~CurvePanel() {
+    template<typename FloatType>
+    CurvePanel<FloatType>::~CurvePanel() {
         if (isThreadRunning()) {
             stopThread(-1);
         }
         parametersNARef.removeParameterListener(zlState::maximumDB::ID, this);
+        parametersNARef.removeParameterListener(zlState::phaseView::ID, this);
     }
 
-    void CurvePanel::paint(juce::Graphics &g) {
+    template<typename FloatType>
+    void CurvePanel<FloatType>::paint(juce::Graphics &g) {
         juce::ignoreUnused(g);
     }
 
-    void CurvePanel::paintOverChildren(juce::Graphics &g) {
+    template<typename FloatType>
+    void CurvePanel<FloatType>::paintOverChildren(juce::Graphics &g) {
         juce::ignoreUnused(g);
         notify();
     }
 
-    void CurvePanel::resized() {
+    template<typename FloatType>
+    void CurvePanel<FloatType>::resized() {
         backgroundPanel.setBounds(getLocalBounds());
         auto bound = getLocalBounds().toFloat();
         bound.removeFromRight(uiBase.getFontSize() * 4.1f);
@@ -67,11 +77,13 @@ namespace zlPanel {
             singlePanels[i]->setBounds(bound.toNearestInt());
         }
         sumPanel.setBounds(bound.toNearestInt());
+        phasePanel.setBounds(bound.toNearestInt());
         soloPanel.setBounds(bound.toNearestInt());
         buttonPanel.setBounds(bound.toNearestInt());
     }
 
-    void CurvePanel::parameterChanged(const juce::String &parameterID, float newValue) {
+    template<typename FloatType>
+    void CurvePanel<FloatType>::parameterChanged(const juce::String &parameterID, float newValue) {
         if (parameterID == zlState::maximumDB::ID) {
             const auto idx = static_cast<size_t>(newValue);
             const auto maxDB = zlState::maximumDB::dBs[idx];
@@ -80,10 +92,13 @@ namespace zlPanel {
             for (size_t i = 0; i < zlState::bandNUM; ++i) {
                 singlePanels[i]->setMaximumDB(maxDB);
             }
+        } else if (parameterID == zlState::phaseView::ID) {
+            phasePanel.setView(static_cast<typename PhasePanel<FloatType>::PhaseView>(static_cast<int>(newValue)));
         }
     }
 
-    void CurvePanel::repaintCallBack() {
+    template<typename FloatType>
+    void CurvePanel<FloatType>::repaintCallBack() {
         const auto &analyzer = controllerRef.getAnalyzer();
         const juce::Time nowT = juce::Time::getCurrentTime();
         if ((nowT - currentT).inMilliseconds() > uiBase.getRefreshRateMS()) {
@@ -98,7 +113,8 @@ namespace zlPanel {
         }
     }
 
-    void CurvePanel::run() {
+    template<typename FloatType>
+    void CurvePanel<FloatType>::run() {
         juce::ScopedNoDenormals noDenormals;
         while (!threadShouldExit()) {
             const auto flag = wait(-1);
@@ -109,6 +125,13 @@ namespace zlPanel {
                 }
             }
             sumPanel.run();
+            phasePanel.run();
         }
     }
+
+    template
+    class CurvePanel<float>;
+
+    template
+    class CurvePanel<double>;
 }
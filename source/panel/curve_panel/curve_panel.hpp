@@ -15,11 +15,13 @@
 #include "fft_panel/fft_panel.hpp"
 #include "sum_panel/sum_panel.hpp"
 #include "sum_panel/solo_panel.hpp"
+#include "sum_panel/phase_panel.hpp"
 #include "single_panel/single_panel.hpp"
 #include "button_panel/button_panel.hpp"
 #include "conflict_panel/conflict_panel.hpp"
 
 namespace zlPanel {
+    template<typename FloatType>
     class CurvePanel final : public juce::Component,
                              private juce::AudioProcessorValueTreeState::Listener,
                              private juce::Thread {
@@ -27,7 +29,7 @@ namespace zlPanel {
         explicit CurvePanel(juce::AudioProcessorValueTreeState &parameters,
                             juce::AudioProcessorValueTreeState &parametersNA,
                             zlInterface::UIBase &base,
-                            zlDSP::Controller<double> &c);
+                            zlDSP::Controller<FloatType> &c);
 
         ~CurvePanel() override;
 
@@ -40,14 +42,15 @@ namespace zlPanel {
     private:
         juce::AudioProcessorValueTreeState &parametersNARef;
         zlInterface::UIBase &uiBase;
-        zlDSP::Controller<double> &controllerRef;
+        zlDSP::Controller<FloatType> &controllerRef;
         BackgroundPanel backgroundPanel;
-        FFTPanel fftPanel;
-        ConflictPanel conflictPanel;
-        SumPanel sumPanel;
-        SoloPanel soloPanel;
-        ButtonPanel buttonPanel;
-        std::array<std::unique_ptr<SinglePanel>, zlState::bandNUM> singlePanels;
+        FFTPanel<FloatType> fftPanel;
+        ConflictPanel<FloatType> conflictPanel;
+        SumPanel<FloatType> sumPanel;
+        PhasePanel<FloatType> phasePanel;
+        SoloPanel<FloatType> soloPanel;
+        ButtonPanel<FloatType> buttonPanel;
+        std::array<std::unique_ptr<SinglePanel<FloatType>>, zlState::bandNUM> singlePanels;
         juce::Time currentT;
         juce::VBlankAttachment vblank;
 
@@ -10,18 +10,21 @@
 #include "fft_panel.hpp"
 
 namespace zlPanel {
-    FFTPanel::FFTPanel(zlFFT::PrePostFFTAnalyzer<double> &analyzer,
-                       zlInterface::UIBase &base)
+    template<typename FloatType>
+    FFTPanel<FloatType>::FFTPanel(zlFFT::PrePostFFTAnalyzer<FloatType> &analyzer,
+                                  zlInterface::UIBase &base)
         : analyzerRef(analyzer), uiBase(base) {
         setInterceptsMouseClicks(false, false);
         analyzerRef.setON(true);
     }
 
-    FFTPanel::~FFTPanel() {
+    template<typename FloatType>
+    FFTPanel<FloatType>::~FFTPanel() {
         analyzerRef.setON(false);
     }
 
-    void FFTPanel::paint(juce::Graphics &g) {
+    template<typename FloatType>
+    void FFTPanel<FloatType>::paint(juce::Graphics &g) {
         if (analyzerRef.getPreON() && !path1.isEmpty()) {
             g.setColour(uiBase.getColourByIdx(zlInterface::preColour));
             g.fillPath(path1);
@@ -43,13 +46,15 @@ namespace zlPanel {
         }
     }
 
-    void FFTPanel::resized() {
+    template<typename FloatType>
+    void FFTPanel<FloatType>::resized() {
         const auto bound = getLocalBounds().toFloat();
         leftCorner = {bound.getX() * 0.9f, bound.getBottom() * 1.1f};
         rightCorner = {bound.getRight() * 1.1f, bound.getBottom() * 1.1f};
     }
 
-    void FFTPanel::updatePaths() {
+    template<typename FloatType>
+    void FFTPanel<FloatType>::updatePaths() {
         analyzerRef.updatePaths(path1, path2, path3, getLocalBounds().toFloat());
         for (auto &path : {&path1, &path2, &path3}) {
             if (!path->isEmpty()) {
@@ -59,4 +64,10 @@ namespace zlPanel {
             }
         }
     }
+
+    template
+    class FFTPanel<float>;
+
+    template
+    class FFTPanel<double>;
 } // zlPanel
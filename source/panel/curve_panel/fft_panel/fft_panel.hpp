@@ -14,9 +14,10 @@
 #include "../../../gui/gui.hpp"
 
 namespace zlPanel {
+    template<typename FloatType>
     class FFTPanel final : public juce::Component {
     public:
-        explicit FFTPanel(zlFFT::PrePostFFTAnalyzer<double> &analyzer,
+        explicit FFTPanel(zlFFT::PrePostFFTAnalyzer<FloatType> &analyzer,
                           zlInterface::UIBase &base);
 
         ~FFTPanel() override;
@@ -28,7 +29,7 @@ namespace zlPanel {
         void updatePaths();
 
     private:
-        zlFFT::PrePostFFTAnalyzer<double> &analyzerRef;
+        zlFFT::PrePostFFTAnalyzer<FloatType> &analyzerRef;
         zlInterface::UIBase &uiBase;
         juce::Path path1{}, path2{}, path3{};
         juce::Point<float> leftCorner, rightCorner;
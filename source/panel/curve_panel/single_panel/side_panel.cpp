@@ -10,9 +10,10 @@
 #include "side_panel.hpp"
 
 namespace zlPanel {
-    SidePanel::SidePanel(size_t bandIdx, juce::AudioProcessorValueTreeState &parameters,
-                         juce::AudioProcessorValueTreeState &parametersNA, zlInterface::UIBase &base,
-                         zlDSP::Controller<double> &controller)
+    template<typename FloatType>
+    SidePanel<FloatType>::SidePanel(size_t bandIdx, juce::AudioProcessorValueTreeState &parameters,
+                                    juce::AudioProcessorValueTreeState &parametersNA, zlInterface::UIBase &base,
+                                    zlDSP::Controller<FloatType> &controller)
         : idx(bandIdx),
           parametersRef(parameters), parametersNARef(parametersNA),
           uiBase(base),
@@ -40,7 +41,8 @@ namespace zlPanel {
         update();
     }
 
-    SidePanel::~SidePanel() {
+    template<typename FloatType>
+    SidePanel<FloatType>::~SidePanel() {
         const std::string suffix = zlDSP::appendSuffix("", idx);
         for (auto &id: changeIDs) {
             parametersRef.removeParameterListener(id + suffix, this);
@@ -49,7 +51,8 @@ namespace zlPanel {
         parametersNARef.removeParameterListener(zlState::active::ID + suffix, this);
     }
 
-    void SidePanel::paint(juce::Graphics &g) {
+    template<typename FloatType>
+    void SidePanel<FloatType>::paint(juce::Graphics &g) {
         if (!selected.load() || !actived.load() || !dynON.load()) {
             return;
         }
@@ -66,14 +69,16 @@ namespace zlPanel {
         g.drawLine(x1, bound.getBottom(), x2, bound.getBottom(), thickness);
     }
 
-    bool SidePanel::checkRepaint() {
+    template<typename FloatType>
+    bool SidePanel<FloatType>::checkRepaint() {
         if (toRepaint.exchange(false)) {
             return true;
         }
         return false;
     }
 
-    void SidePanel::parameterChanged(const juce::String &parameterID, float newValue) {
+    template<typename FloatType>
+    void SidePanel<FloatType>::parameterChanged(const juce::String &parameterID, float newValue) {
         if (parameterID == zlState::selectedBandIdx::ID) {
             selected.store(static_cast<size_t>(newValue) == idx);
         } else {
@@ -94,7 +99,8 @@ namespace zlPanel {
         }
     }
 
-    void SidePanel::update() {
+    template<typename FloatType>
+    void SidePanel<FloatType>::update() {
         const auto q = sideQ.load(), freq = sideFreq.load();
         const auto bw = 2 * std::asinh(0.5f / q) / std::log(2.f);
         const auto scale = std::pow(2.f, bw / 2.f);
@@ -103,4 +109,10 @@ namespace zlPanel {
         scale1.store(std::log(static_cast<float>(freq1) / 10.f) / std::log(2200.f));
         scale2.store(std::log(static_cast<float>(freq2) / 10.f) / std::log(2200.f));
     }
+
+    template
+    class SidePanel<float>;
+
+    template
+    class SidePanel<double>;
 } // zlPanel
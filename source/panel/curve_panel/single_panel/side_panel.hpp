@@ -17,6 +17,7 @@
 #include "../../../state/state_definitions.hpp"
 
 namespace zlPanel {
+    template<typename FloatType>
     class SidePanel final : public juce::Component,
                             private juce::AudioProcessorValueTreeState::Listener {
     public:
@@ -24,7 +25,7 @@ namespace zlPanel {
                            juce::AudioProcessorValueTreeState &parameters,
                            juce::AudioProcessorValueTreeState &parametersNA,
                            zlInterface::UIBase &base,
-                           zlDSP::Controller<double> &controller);
+                           zlDSP::Controller<FloatType> &controller);
 
         ~SidePanel() override;
 
@@ -36,7 +37,7 @@ namespace zlPanel {
         size_t idx;
         juce::AudioProcessorValueTreeState &parametersRef, &parametersNARef;
         zlInterface::UIBase &uiBase;
-        zlIIR::Filter<double> &sideF;
+        zlIIR::Filter<FloatType> &sideF;
         std::atomic<bool> dynON, selected, actived;
         std::atomic<bool> toRepaint{false};
 
@@ -10,11 +10,12 @@
 #include "single_panel.hpp"
 
 namespace zlPanel {
-    SinglePanel::SinglePanel(const size_t bandIdx,
-                             juce::AudioProcessorValueTreeState &parameters,
-                             juce::AudioProcessorValueTreeState &parametersNA,
-                             zlInterface::UIBase &base,
-                             zlDSP::Controller<double> &controller)
+    template<typename FloatType>
+    SinglePanel<FloatType>::SinglePanel(const size_t bandIdx,
+                                        juce::AudioProcessorValueTreeState &parameters,
+                                        juce::AudioProcessorValueTreeState &parametersNA,
+                                        zlInterface::UIBase &base,
+                                        zlDSP::Controller<FloatType> &controller)
         : idx(bandIdx), parametersRef(parameters), parametersNARef(parametersNA),
           uiBase(base), controllerRef(controller),
           filter(controller.getFilter(idx)),
@@ -47,7 +48,8 @@ namespace zlPanel {
         skipRepaint.store(false);
     }
 
-    SinglePanel::~SinglePanel() {
+    template<typename FloatType>
+    SinglePanel<FloatType>::~SinglePanel() {
         const std::string suffix = idx < 10 ? "0" + std::to_string(idx) : std::to_string(idx);
         for (auto &id: changeIDs) {
             parametersRef.removeParameterListener(id + suffix, this);
@@ -57,7 +59,8 @@ namespace zlPanel {
         parametersNARef.removeParameterListener(zlState::active::ID + suffix, this);
     }
 
-    void SinglePanel::paint(juce::Graphics &g) {
+    template<typename FloatType>
+    void SinglePanel<FloatType>::paint(juce::Graphics &g) {
         if (!actived.load()) {
             return;
         }
@@ -134,7 +137,8 @@ namespace zlPanel {
         }
     }
 
-    void SinglePanel::resized() {
+    template<typename FloatType>
+    void SinglePanel<FloatType>::resized() {
         const auto bound = getLocalBounds().toFloat();
         xx.store(bound.getX());
         yy.store(bound.getY());
@@ -144,11 +148,13 @@ namespace zlPanel {
         toRepaint.store(true);
     }
 
-    bool SinglePanel::willRepaint() const {
+    template<typename FloatType>
+    bool SinglePanel<FloatType>::willRepaint() const {
         return toRepaint.load();
     }
 
-    bool SinglePanel::checkRepaint() {
+    template<typename FloatType>
+    bool SinglePanel<FloatType>::checkRepaint() {
         if (baseF.getMagOutdated() || targetF.getMagOutdated()) {
             return true;
         } else if (toRepaint.exchange(false)) {
@@ -157,11 +163,12 @@ namespace zlPanel {
         return sidePanel.checkRepaint();
     }
 
-    void SinglePanel::drawCurve(juce::Path &path,
-                                const std::array<double, zlIIR::frequencies.size()> &dBs,
-                                juce::Rectangle<float> bound,
-                                const bool reverse,
-                                const bool startPath) {
+    template<typename FloatType>
+    void SinglePanel<FloatType>::drawCurve(juce::Path &path,
+                                           const std::array<double, zlIIR::frequencies.size()> &dBs,
+                                           juce::Rectangle<float> bound,
+                                           const bool reverse,
+                                           const bool startPath) {
         bound = bound.withSizeKeepingCentre(bound.getWidth(), bound.getHeight() - 2 * uiBase.getFontSize());
         const auto maxDB = maximumDB.load();
         if (reverse) {
@@ -194,7 +201,8 @@ namespace zlPanel {
         }
     }
 
-    void SinglePanel::parameterChanged(const juce::String &parameterID, float newValue) {
+    template<typename FloatType>
+    void SinglePanel<FloatType>::parameterChanged(const juce::String &parameterID, float newValue) {
         if (parameterID == zlState::selectedBandIdx::ID) {
             selected.store(static_cast<size_t>(newValue) == idx);
         } else {
@@ -209,7 +217,8 @@ namespace zlPanel {
         toRepaint.store(true);
     }
 
-    void SinglePanel::run() {
+    template<typename FloatType>
+    void SinglePanel<FloatType>::run() {
         juce::ScopedNoDenormals noDenormals;
         const juce::Rectangle<float> bound{xx.load(), yy.load(), width.load(), height.load()};
         // draw curve
@@ -281,4 +290,10 @@ namespace zlPanel {
             *pathLock = dynPath;
         }
     }
+
+    template
+    class SinglePanel<float>;
+
+    template
+    class SinglePanel<double>;
 } // zlPanel
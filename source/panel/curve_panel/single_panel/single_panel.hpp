@@ -18,6 +18,7 @@
 #include "side_panel.hpp"
 
 namespace zlPanel {
+    template<typename FloatType>
     class SinglePanel final : public juce::Component,
                               private juce::AudioProcessorValueTreeState::Listener {
     public:
@@ -25,7 +26,7 @@ namespace zlPanel {
                              juce::AudioProcessorValueTreeState &parameters,
                              juce::AudioProcessorValueTreeState &parametersNA,
                              zlInterface::UIBase &base,
-                             zlDSP::Controller<double> &controller);
+                             zlDSP::Controller<FloatType> &controller);
 
         ~SinglePanel() override;
 
@@ -53,16 +54,16 @@ namespace zlPanel {
         juce::AudioProcessorValueTreeState &parametersRef, &parametersNARef;
         zlInterface::UIBase &uiBase;
         std::atomic<bool> dynON, selected, actived;
-        zlDSP::Controller<double> &controllerRef;
-        zlDynamicFilter::IIRFilter<double> &filter;
-        zlIIR::Filter<double> &baseF, &targetF;
+        zlDSP::Controller<FloatType> &controllerRef;
+        zlDynamicFilter::IIRFilter<FloatType> &filter;
+        zlIIR::Filter<FloatType> &baseF, &targetF;
         std::atomic<float> maximumDB;
         std::atomic<float> xx{-100.f}, yy{-100.f}, width{.1f}, height{.1f};
 
         std::atomic<bool> skipRepaint{false};
         std::atomic<bool> toRepaint{false};
         std::atomic<bool> avoidRepaint{false};
-        SidePanel sidePanel;
+        SidePanel<FloatType> sidePanel;
         std::atomic<float> centeredDB{0.f};
         std::atomic<double> baseFreq{1000.0}, baseGain{0.0};
 
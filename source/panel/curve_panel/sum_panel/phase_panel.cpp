@@ -0,0 +1,155 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#include "phase_panel.hpp"
+
+namespace zlPanel {
+    template<typename FloatType>
+    PhasePanel<FloatType>::PhasePanel(juce::AudioProcessorValueTreeState &parameters,
+                                      zlInterface::UIBase &base,
+                                      zlDSP::Controller<FloatType> &controller)
+        : parametersRef(parameters),
+          uiBase(base), c(controller) {
+        for (auto &path: paths) {
+            path.preallocateSpace(static_cast<int>(zlIIR::frequencies.size() * 3));
+        }
+        for (size_t i = 0; i < zlDSP::bandNUM; ++i) {
+            for (const auto &idx: changeIDs) {
+                parametersRef.addParameterListener(zlDSP::appendSuffix(idx, i), this);
+            }
+        }
+        setInterceptsMouseClicks(false, false);
+    }
+
+    template<typename FloatType>
+    PhasePanel<FloatType>::~PhasePanel() {
+        for (size_t i = 0; i < zlDSP::bandNUM; ++i) {
+            for (const auto &idx: changeIDs) {
+                parametersRef.removeParameterListener(zlDSP::appendSuffix(idx, i), this);
+            }
+        }
+    }
+
+    template<typename FloatType>
+    void PhasePanel<FloatType>::paint(juce::Graphics &g) {
+        if (view.load() == off) { return; }
+        for (size_t j = 0; j < routeNum; ++j) {
+            g.setColour(uiBase.getColorMap2(j).withMultipliedAlpha(.5f));
+            farbot::RealtimeObject<
+                juce::Path,
+                farbot::RealtimeObjectOptions::realtimeMutatable>::ScopedAccess<
+                farbot::ThreadType::nonRealtime> pathLock(recentPaths[j]);
+            g.strokePath(*pathLock, juce::PathStrokeType(uiBase.getFontSize() * 0.1f * uiBase.getSumCurveThickness(),
+                                                         juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
+        }
+    }
+
+    template<typename FloatType>
+    void PhasePanel<FloatType>::run() {
+        juce::ScopedNoDenormals noDenormals;
+        const auto currentView = view.load();
+        const auto forceUpdate = toRepaint.exchange(false);
+        if (currentView == off) {
+            if (forceUpdate) {
+                for (size_t j = 0; j < routeNum; ++j) {
+                    versions[j].fill(0);
+                    paths[j].clear();
+                    farbot::RealtimeObject<
+                        juce::Path,
+                        farbot::RealtimeObjectOptions::realtimeMutatable>::ScopedAccess<
+                        farbot::ThreadType::realtime> pathLock(recentPaths[j]);
+                    *pathLock = paths[j];
+                }
+            }
+            return;
+        }
+        for (size_t j = 0; j < routeNum; ++j) {
+            std::array<size_t, zlDSP::bandNUM> currentVersions{};
+            bool isUsed = false;
+            for (size_t i = 0; i < zlDSP::bandNUM; ++i) {
+                if (static_cast<size_t>(c.getFilterLRs(i)) == j && !c.getFilter(i).getBypass()) {
+                    currentVersions[i] = c.getFilter(i).getMainFilter().getCoeffVersion() + 1;
+                    isUsed = true;
+                }
+            }
+            if (!forceUpdate && currentVersions == versions[j]) { continue; }
+            versions[j] = currentVersions;
+            useLRMS[j] = isUsed;
+            updatePath(j, currentView);
+            farbot::RealtimeObject<
+                juce::Path,
+                farbot::RealtimeObjectOptions::realtimeMutatable>::ScopedAccess<
+                farbot::ThreadType::realtime> pathLock(recentPaths[j]);
+            *pathLock = paths[j];
+        }
+    }
+
+    template<typename FloatType>
+    void PhasePanel<FloatType>::updatePath(const size_t j, const PhaseView currentView) {
+        paths[j].clear();
+        if (!useLRMS[j]) { return; }
+        constexpr std::array<zlDSP::lrType::lrTypes, routeNum> lrTypes{
+            zlDSP::lrType::stereo, zlDSP::lrType::left, zlDSP::lrType::right, zlDSP::lrType::mid,
+            zlDSP::lrType::side
+        };
+        c.updateResponses(lrTypes[j], response);
+
+        juce::Rectangle<float> bound{xx.load(), yy.load(), width.load(), height.load()};
+        bound = bound.withSizeKeepingCentre(bound.getWidth(), bound.getHeight() - 2 * uiBase.getFontSize());
+        const auto scale = currentView == phase
+                               ? 1.0 / juce::MathConstants<double>::pi
+                               : 1000.0 / maximumDelay;
+
+        bool startNew = true;
+        float y0 = 0.f;
+        double v0 = 0.0;
+        for (size_t i = 0; i < zlIIR::frequencies.size(); ++i) {
+            const auto v = currentView == phase ? response.getPhase(i) : response.delays[i];
+            const auto x = static_cast<float>(i) / static_cast<float>(zlIIR::frequencies.size() - 1) * bound.
+                           getWidth();
+            const auto y = static_cast<float>(-std::clamp(v * scale, -1.0, 1.0)) * bound.getHeight() * 0.5f +
+                           bound.getCentreY();
+            // do not connect the wrapped phase across +-pi
+            if (currentView == phase && i > 0 && std::abs(v - v0) > juce::MathConstants<double>::pi) {
+                startNew = true;
+            }
+            v0 = v;
+            if (startNew) {
+                paths[j].startNewSubPath(x, y);
+                y0 = y;
+                startNew = false;
+            } else if (std::abs(y - y0) >= 0.125f || i == zlIIR::frequencies.size() - 1) {
+                paths[j].lineTo(x, y);
+                y0 = y;
+            }
+        }
+    }
+
+    template<typename FloatType>
+    void PhasePanel<FloatType>::parameterChanged(const juce::String &parameterID, float newValue) {
+        juce::ignoreUnused(parameterID, newValue);
+        toRepaint.store(true);
+    }
+
+    template<typename FloatType>
+    void PhasePanel<FloatType>::resized() {
+        const auto bound = getLocalBounds().toFloat();
+        xx.store(bound.getX());
+        yy.store(bound.getY());
+        width.store(bound.getWidth());
+        height.store(bound.getHeight());
+        toRepaint.store(true);
+    }
+
+    template
+    class PhasePanel<float>;
+
+    template
+    class PhasePanel<double>;
+} // zlPanel
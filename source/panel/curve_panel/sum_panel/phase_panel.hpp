@@ -0,0 +1,79 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ZLEqualizer_PHASE_PANEL_HPP
+#define ZLEqualizer_PHASE_PANEL_HPP
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "../../../dsp/dsp.hpp"
+#include "../../../gui/gui.hpp"
+#include "../../../dsp/farbot/RealtimeObject.hpp"
+
+namespace zlPanel {
+    /**
+     * overlays the phase or the group delay of the sum of each L/R/M/S route
+     * the responses are evaluated on the curve panel thread, and a route is only re-evaluated
+     * when the coefficients or the filters on it change
+     * @tparam FloatType
+     */
+    template<typename FloatType>
+    class PhasePanel final : public juce::Component,
+                             private juce::AudioProcessorValueTreeState::Listener {
+    public:
+        enum PhaseView { off, phase, delay };
+
+        explicit PhasePanel(juce::AudioProcessorValueTreeState &parameters,
+                            zlInterface::UIBase &base,
+                            zlDSP::Controller<FloatType> &controller);
+
+        ~PhasePanel() override;
+
+        void paint(juce::Graphics &g) override;
+
+        void setView(const PhaseView x) {
+            view.store(x);
+            toRepaint.store(true);
+        }
+
+        void resized() override;
+
+        void run();
+
+        /** the group delay (ms) at the top of the panel */
+        static constexpr double maximumDelay = 10.0;
+
+    private:
+        static constexpr size_t routeNum = 5;
+        std::array<juce::Path, routeNum> paths;
+        std::array<farbot::RealtimeObject<juce::Path, farbot::RealtimeObjectOptions::realtimeMutatable>, routeNum>
+        recentPaths;
+        juce::AudioProcessorValueTreeState &parametersRef;
+        zlInterface::UIBase &uiBase;
+        zlDSP::Controller<FloatType> &c;
+        std::atomic<PhaseView> view{off};
+        std::atomic<float> xx{-100.f}, yy{-100.f}, width{.1f}, height{.1f};
+
+        zlIIR::ResponseEngine::ComplexResponse response;
+        /** the coefficient versions of the filters on each route when it was evaluated, 0 if not on the route */
+        std::array<std::array<size_t, zlDSP::bandNUM>, routeNum> versions{};
+        std::array<bool, routeNum> useLRMS{};
+
+        static constexpr std::array changeIDs{
+            zlDSP::bypass::ID, zlDSP::lrType::ID
+        };
+        std::atomic<bool> toRepaint{false};
+
+        void parameterChanged(const juce::String &parameterID, float newValue) override;
+
+        void updatePath(size_t j, PhaseView currentView);
+    };
+} // zlPanel
+
+#endif //ZLEqualizer_PHASE_PANEL_HPP
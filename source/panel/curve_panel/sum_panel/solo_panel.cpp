@@ -12,9 +12,10 @@
 #include "../../../state/state_definitions.hpp"
 
 namespace zlPanel {
-    SoloPanel::SoloPanel(juce::AudioProcessorValueTreeState &parameters,
-                         juce::AudioProcessorValueTreeState &parametersNA, zlInterface::UIBase &base,
-                         zlDSP::Controller<double> &controller)
+    template<typename FloatType>
+    SoloPanel<FloatType>::SoloPanel(juce::AudioProcessorValueTreeState &parameters,
+                                    juce::AudioProcessorValueTreeState &parametersNA, zlInterface::UIBase &base,
+                                    zlDSP::Controller<FloatType> &controller)
         : parametersRef(parameters), uiBase(base),
           soloF(controller.getSoloFilter()),
           controllerRef(controller) {
@@ -28,7 +29,8 @@ namespace zlPanel {
         triggerAsyncUpdate();
     }
 
-    SoloPanel::~SoloPanel() {
+    template<typename FloatType>
+    SoloPanel<FloatType>::~SoloPanel() {
         for (size_t idx = 0; idx < zlState::bandNUM; ++idx) {
             const std::string suffix = idx < 10 ? "0" + std::to_string(idx) : std::to_string(idx);
             for (auto &id: changeIDs) {
@@ -37,7 +39,8 @@ namespace zlPanel {
         }
     }
 
-    void SoloPanel::paint(juce::Graphics &g) {
+    template<typename FloatType>
+    void SoloPanel<FloatType>::paint(juce::Graphics &g) {
         if (!controllerRef.getSolo()) {
             return;
         }
@@ -68,7 +71,8 @@ namespace zlPanel {
         g.restoreState();
     }
 
-    void SoloPanel::checkRepaint() {
+    template<typename FloatType>
+    void SoloPanel<FloatType>::checkRepaint() {
         if (soloF.getMagOutdated()) {
             soloF.setMagOutdated(false);
             handleAsyncUpdate();
@@ -80,12 +84,14 @@ namespace zlPanel {
         }
     }
 
-    void SoloPanel::parameterChanged(const juce::String &parameterID, float newValue) {
+    template<typename FloatType>
+    void SoloPanel<FloatType>::parameterChanged(const juce::String &parameterID, float newValue) {
         juce::ignoreUnused(parameterID, newValue);
         toRepaint.store(true);
     }
 
-    void SoloPanel::handleAsyncUpdate() {
+    template<typename FloatType>
+    void SoloPanel<FloatType>::handleAsyncUpdate() {
         const auto q = soloF.getQ(), freq = soloF.getFreq();
         const auto bw = 2 * std::asinh(0.5f / q) / std::log(2.f);
         const auto scale = std::pow(2.f, bw / 2.f);
@@ -94,4 +100,10 @@ namespace zlPanel {
         scale1.store(std::log(static_cast<float>(freq1) / 10.f) / std::log(2200.f));
         scale2.store(std::log(static_cast<float>(freq2) / 10.f) / std::log(2200.f));
     }
+
+    template
+    class SoloPanel<float>;
+
+    template
+    class SoloPanel<double>;
 } // zlPanel
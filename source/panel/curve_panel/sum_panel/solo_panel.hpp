@@ -14,6 +14,7 @@
 #include "../../../gui/gui.hpp"
 
 namespace zlPanel {
+    template<typename FloatType>
     class SoloPanel final : public juce::Component,
                             private juce::AudioProcessorValueTreeState::Listener,
                             private juce::AsyncUpdater {
@@ -21,7 +22,7 @@ namespace zlPanel {
         SoloPanel(juce::AudioProcessorValueTreeState &parameters,
                   juce::AudioProcessorValueTreeState &parametersNA,
                   zlInterface::UIBase &base,
-                  zlDSP::Controller<double> &controller);
+                  zlDSP::Controller<FloatType> &controller);
 
         ~SoloPanel() override;
 
@@ -32,8 +33,8 @@ namespace zlPanel {
     private:
         juce::AudioProcessorValueTreeState &parametersRef;
         zlInterface::UIBase &uiBase;
-        zlIIR::Filter<double> &soloF;
-        zlDSP::Controller<double> &controllerRef;
+        zlIIR::Filter<FloatType> &soloF;
+        zlDSP::Controller<FloatType> &controllerRef;
         std::atomic<float> scale1{.5f}, scale2{.5f};
         std::atomic<bool> toRepaint{false};
 
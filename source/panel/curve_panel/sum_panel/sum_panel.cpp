@@ -10,9 +10,10 @@
 #include "sum_panel.hpp"
 
 namespace zlPanel {
-    SumPanel::SumPanel(juce::AudioProcessorValueTreeState &parameters,
-                       zlInterface::UIBase &base,
-                       zlDSP::Controller<double> &controller)
+    template<typename FloatType>
+    SumPanel<FloatType>::SumPanel(juce::AudioProcessorValueTreeState &parameters,
+                                  zlInterface::UIBase &base,
+                                  zlDSP::Controller<FloatType> &controller)
         : parametersRef(parameters),
           uiBase(base), c(controller) {
         for (auto &path: paths) {
@@ -26,7 +27,8 @@ namespace zlPanel {
         juce::ignoreUnused(parametersRef);
     }
 
-    SumPanel::~SumPanel() {
+    template<typename FloatType>
+    SumPanel<FloatType>::~SumPanel() {
         for (size_t i = 0; i < zlDSP::bandNUM; ++i) {
             for (const auto &idx: changeIDs) {
                 parametersRef.removeParameterListener(zlDSP::appendSuffix(idx, i), this);
@@ -34,7 +36,8 @@ namespace zlPanel {
         }
     }
 
-    void SumPanel::paint(juce::Graphics &g) {
+    template<typename FloatType>
+    void SumPanel<FloatType>::paint(juce::Graphics &g) {
         std::array<bool, 5> useLRMS{false, false, false, false, false};
         for (size_t i = 0; i < zlDSP::bandNUM; ++i) {
             const auto idx = static_cast<size_t>(c.getFilterLRs(i));
@@ -54,7 +57,8 @@ namespace zlPanel {
         }
     }
 
-    bool SumPanel::checkRepaint() {
+    template<typename FloatType>
+    bool SumPanel<FloatType>::checkRepaint() {
         for (size_t i = 0; i < zlState::bandNUM; ++i) {
             if (c.getFilter(i).getMainFilter().getMagOutdated()) {
                 return true;
@@ -66,7 +70,8 @@ namespace zlPanel {
         return false;
     }
 
-    void SumPanel::run() {
+    template<typename FloatType>
+    void SumPanel<FloatType>::run() {
         juce::ScopedNoDenormals noDenormals;
         std::array<bool, 5> useLRMS{false, false, false, false, false};
         constexpr std::array<zlDSP::lrType::lrTypes, 5> lrTypes{
@@ -116,12 +121,14 @@ namespace zlPanel {
         }
     }
 
-    void SumPanel::parameterChanged(const juce::String &parameterID, float newValue) {
+    template<typename FloatType>
+    void SumPanel<FloatType>::parameterChanged(const juce::String &parameterID, float newValue) {
         juce::ignoreUnused(parameterID, newValue);
         toRepaint.store(true);
     }
 
-    void SumPanel::resized() {
+    template<typename FloatType>
+    void SumPanel<FloatType>::resized() {
         const auto bound = getLocalBounds().toFloat();
         xx.store(bound.getX());
         yy.store(bound.getY());
@@ -129,4 +136,10 @@ namespace zlPanel {
         height.store(bound.getHeight());
         toRepaint.store(true);
     }
+
+    template
+    class SumPanel<float>;
+
+    template
+    class SumPanel<double>;
 } // zlPanel
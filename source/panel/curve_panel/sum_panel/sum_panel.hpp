@@ -17,12 +17,13 @@
 #include "../../../dsp/farbot/RealtimeObject.hpp"
 
 namespace zlPanel {
+    template<typename FloatType>
     class SumPanel final : public juce::Component,
                            private juce::AudioProcessorValueTreeState::Listener {
     public:
         explicit SumPanel(juce::AudioProcessorValueTreeState &parameters,
                           zlInterface::UIBase &base,
-                          zlDSP::Controller<double> &controller);
+                          zlDSP::Controller<FloatType> &controller);
 
         ~SumPanel() override;
 
@@ -44,7 +45,7 @@ namespace zlPanel {
         std::array<farbot::RealtimeObject<juce::Path, farbot::RealtimeObjectOptions::realtimeMutatable>, 5> recentPaths;
         juce::AudioProcessorValueTreeState &parametersRef;
         zlInterface::UIBase &uiBase;
-        zlDSP::Controller<double> &c;
+        zlDSP::Controller<FloatType> &c;
         std::atomic<float> maximumDB;
         std::atomic<float> xx{-100.f}, yy{-100.f}, width{.1f}, height{.1f};
 
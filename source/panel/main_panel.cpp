@@ -13,12 +13,11 @@ namespace zlPanel {
     MainPanel::MainPanel(PluginProcessor &p)
         : processorRef(p), state(p.state), uiBase(p.state),
           controlPanel(p.parameters, p.parametersNA, uiBase),
-          curvePanel(p.parameters, p.parametersNA, uiBase, p.getController()),
           statePanel(p.parameters, p.parametersNA, p.state, uiBase),
           uiSettingPanel(p, uiBase), uiSettingButton(uiSettingPanel, uiBase) {
         uiBase.setStyle(static_cast<size_t>(state.getRawParameterValue(zlState::uiStyle::ID)->load()));
         uiBase.loadFromAPVTS();
-        addAndMakeVisible(curvePanel);
+        updateCurvePanel();
         addAndMakeVisible(controlPanel);
         addAndMakeVisible(statePanel);
         addChildComponent(uiSettingButton);
@@ -31,6 +30,7 @@ namespace zlPanel {
         state.addParameterListener(zlState::fftExtraTilt::ID, this);
         state.addParameterListener(zlState::fftExtraSpeed::ID, this);
         state.addParameterListener(zlState::refreshRate::ID, this);
+        processorRef.parameters.addParameterListener(zlDSP::precision::ID, this);
     }
 
     MainPanel::~MainPanel() {
@@ -38,6 +38,7 @@ namespace zlPanel {
         state.removeParameterListener(zlState::fftExtraTilt::ID, this);
         state.removeParameterListener(zlState::fftExtraSpeed::ID, this);
         state.removeParameterListener(zlState::refreshRate::ID, this);
+        processorRef.parameters.removeParameterListener(zlDSP::precision::ID, this);
     }
 
     void MainPanel::paint(juce::Graphics &g) {
@@ -58,7 +59,7 @@ namespace zlPanel {
         const auto controlBound = bound.removeFromBottom(bound.getWidth() * 0.105f);
         controlPanel.setBounds(controlBound.toNearestInt());
 
-        curvePanel.setBounds(bound.toNearestInt());
+        curvePanel->setBounds(bound.toNearestInt());
     }
 
     void MainPanel::parameterChanged(const juce::String &parameterID, float newValue) {
@@ -68,23 +69,49 @@ namespace zlPanel {
 
     void MainPanel::handleAsyncUpdate() {
         uiSettingButton.setVisible(uiBase.getStyle() == 2);
+        updateCurvePanel();
         updateFFTs();
     }
 
     void MainPanel::updateFFTs() {
-        for (auto &fft : {&processorRef.getController().getAnalyzer().getSideFFT()}) {
+        updateFFTs(processorRef.getController<double>());
+        updateFFTs(processorRef.getController<float>());
+    }
+
+    template<typename FloatType>
+    void MainPanel::updateFFTs(zlDSP::Controller<FloatType> &controller) {
+        for (auto &fft : {&controller.getAnalyzer().getSideFFT()}) {
             fft->setExtraTilt(uiBase.getFFTExtraTilt());
             fft->setExtraSpeed(uiBase.getFFTExtraSpeed());
             fft->setRefreshRate(zlState::refreshRate::rates[uiBase.getRefreshRateID()]);
         }
-        for (auto &fft : {&processorRef.getController().getAnalyzer().getSyncFFT()}) {
+        for (auto &fft : {&controller.getAnalyzer().getSyncFFT()}) {
             fft->setExtraTilt(uiBase.getFFTExtraTilt());
             fft->setExtraSpeed(uiBase.getFFTExtraSpeed());
             fft->setRefreshRate(zlState::refreshRate::rates[uiBase.getRefreshRateID()]);
         }
-        for (auto &fft : {&processorRef.getController().getConflictAnalyzer().getSyncFFT()}) {
+        for (auto &fft : {&controller.getConflictAnalyzer().getSyncFFT()}) {
             fft->setRefreshRate(zlState::refreshRate::rates[uiBase.getRefreshRateID()]);
         }
     }
 
+    void MainPanel::updateCurvePanel() {
+        const auto useFloat = processorRef.getUseFloat();
+        if (curvePanel != nullptr && useFloat == curveUseFloat) {
+            return;
+        }
+        curveUseFloat = useFloat;
+        curvePanel.reset();
+        auto &p = processorRef;
+        if (curveUseFloat) {
+            curvePanel = std::make_unique<CurvePanel<float>>(p.parameters, p.parametersNA, uiBase,
+                                                             p.getController<float>());
+        } else {
+            curvePanel = std::make_unique<CurvePanel<double>>(p.parameters, p.parametersNA, uiBase,
+                                                              p.getController<double>());
+        }
+        // keep the curve panel below the other panels
+        addAndMakeVisible(*curvePanel, 0);
+        resized();
+    }
 }
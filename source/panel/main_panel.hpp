@@ -35,7 +35,9 @@ namespace zlPanel {
         juce::AudioProcessorValueTreeState &state;
         zlInterface::UIBase uiBase;
         ControlPanel controlPanel;
-        CurvePanel curvePanel;
+        /** CurvePanel<float> or CurvePanel<double>, following the controller which processes the audio */
+        std::unique_ptr<juce::Component> curvePanel;
+        bool curveUseFloat{false};
         StatePanel statePanel;
         UISettingPanel uiSettingPanel;
         UISettingButton uiSettingButton;
@@ -45,6 +47,11 @@ namespace zlPanel {
         void handleAsyncUpdate() override;
 
         void updateFFTs();
+
+        template<typename FloatType>
+        void updateFFTs(zlDSP::Controller<FloatType> &controller);
+
+        void updateCurvePanel();
     };
 }
 
@@ -20,7 +20,8 @@ namespace zlPanel {
               lookaheadS("Lookahead", uiBase),
               rmsS("RMS", uiBase),
               smoothS("Smooth", uiBase),
-              dynHQC("HQ:", zlDSP::dynHQ::choices, uiBase) {
+              dynHQC("HQ:", zlDSP::dynHQ::choices, uiBase),
+              dynSpectralC("FFT:", zlDSP::dynSpectral::choices, uiBase) {
             for (auto &c: {&lookaheadS, &rmsS, &smoothS}) {
                 c->setPadding(uiBase.getFontSize() * .5f, 0.01f);
                 addAndMakeVisible(c);
@@ -32,17 +33,17 @@ namespace zlPanel {
                        zlDSP::dynLookahead::ID, zlDSP::dynRMS::ID, zlDSP::dynSmooth::ID
                    },
                    parametersRef, sliderAttachments);
-            for (auto &c: {&dynHQC}) {
+            for (auto &c: {&dynHQC, &dynSpectralC}) {
                 c->getLabelLAF().setFontScale(1.5f);
                 c->setLabelScale(.5f);
                 c->setLabelPos(zlInterface::ClickCombobox::left);
                 addAndMakeVisible(c);
             }
             attach({
-                       &dynHQC.getCompactBox().getBox(),
+                       &dynHQC.getCompactBox().getBox(), &dynSpectralC.getCompactBox().getBox()
                    },
                    {
-                       zlDSP::dynHQ::ID
+                       zlDSP::dynHQ::ID, zlDSP::dynSpectral::ID
                    },
                    parametersRef, boxAttachments);
         }
@@ -54,14 +55,17 @@ namespace zlPanel {
             using Track = juce::Grid::TrackInfo;
             using Fr = juce::Grid::Fr;
 
-            grid.templateRows = {Track(Fr(60)), Track(Fr(60)), Track(Fr(60)), Track(Fr(60)), Track(Fr(44))};
+            grid.templateRows = {
+                Track(Fr(60)), Track(Fr(60)), Track(Fr(60)), Track(Fr(60)), Track(Fr(60)), Track(Fr(44))
+            };
             grid.templateColumns = {Track(Fr(50))};
 
             grid.items = {
                 juce::GridItem(lookaheadS).withArea(1, 1),
                 juce::GridItem(rmsS).withArea(2, 1),
                 juce::GridItem(smoothS).withArea(3, 1),
-                juce::GridItem(dynHQC).withArea(4, 1)
+                juce::GridItem(dynHQC).withArea(4, 1),
+                juce::GridItem(dynSpectralC).withArea(5, 1)
             };
 
             grid.setGap(juce::Grid::Px(uiBase.getFontSize() * .4125f));
@@ -75,7 +79,7 @@ namespace zlPanel {
         zlInterface::UIBase &uiBase;
 
         zlInterface::CompactLinearSlider lookaheadS, rmsS, smoothS;
-        zlInterface::ClickCombobox dynHQC;
+        zlInterface::ClickCombobox dynHQC, dynSpectralC;
         juce::OwnedArray<juce::AudioProcessorValueTreeState::SliderAttachment> sliderAttachments{};
         juce::OwnedArray<juce::AudioProcessorValueTreeState::ComboBoxAttachment> boxAttachments{};
     };
@@ -131,7 +135,7 @@ namespace zlPanel {
         }
         auto content = std::make_unique<CompCallOutBox>(parametersRef, uiBase);
         content->setSize(juce::roundToInt(uiBase.getFontSize() * 7.5f),
-                         juce::roundToInt(uiBase.getFontSize() * 11.5201933f));
+                         juce::roundToInt(uiBase.getFontSize() * 13.9540144f));
 
         auto &box = juce::CallOutBox::launchAsynchronously(std::move(content),
                                                            getBounds(),
@@ -19,9 +19,10 @@ namespace zlPanel {
               fftPreON("Pre:", zlState::fftPreON::choices, uiBase),
               fftPostON("Post:", zlState::fftPostON::choices, uiBase),
               fftSideON("Side:", zlState::fftSideON::choices, uiBase),
+              phaseView("Phase:", zlState::phaseView::choices, uiBase),
               ffTSpeed("", zlState::ffTSpeed::choices, uiBase),
               fftTilt("", zlState::ffTTilt::choices, uiBase) {
-            for (auto &c: {&fftPreON, &fftPostON, &fftSideON}) {
+            for (auto &c: {&fftPreON, &fftPostON, &fftSideON, &phaseView}) {
                 c->getLabelLAF().setFontScale(1.5f);
                 c->setLabelScale(.5f);
                 c->setLabelPos(zlInterface::ClickCombobox::left);
@@ -34,11 +35,13 @@ namespace zlPanel {
                        &fftPreON.getCompactBox().getBox(),
                        &fftPostON.getCompactBox().getBox(),
                        &fftSideON.getCompactBox().getBox(),
-                       &ffTSpeed.getBox(), &fftTilt.getBox()
+                       &ffTSpeed.getBox(), &fftTilt.getBox(),
+                       &phaseView.getCompactBox().getBox()
                    },
                    {
                        zlState::fftPreON::ID, zlState::fftPostON::ID, zlState::fftSideON::ID,
-                       zlState::ffTSpeed::ID, zlState::ffTTilt::ID
+                       zlState::ffTSpeed::ID, zlState::ffTTilt::ID,
+                       zlState::phaseView::ID
                    },
                    parametersNARef, boxAttachments);
         }
@@ -50,7 +53,9 @@ namespace zlPanel {
             using Track = juce::Grid::TrackInfo;
             using Fr = juce::Grid::Fr;
 
-            grid.templateRows = {Track(Fr(60)), Track(Fr(60)), Track(Fr(60)), Track(Fr(60)), Track(Fr(60))};
+            grid.templateRows = {
+                Track(Fr(60)), Track(Fr(60)), Track(Fr(60)), Track(Fr(60)), Track(Fr(60)), Track(Fr(60))
+            };
             grid.templateColumns = {Track(Fr(50))};
 
             grid.items = {
@@ -58,7 +63,8 @@ namespace zlPanel {
                 juce::GridItem(fftPostON).withArea(2, 1),
                 juce::GridItem(fftSideON).withArea(3, 1),
                 juce::GridItem(ffTSpeed).withArea(4, 1),
-                juce::GridItem(fftTilt).withArea(5, 1)
+                juce::GridItem(fftTilt).withArea(5, 1),
+                juce::GridItem(phaseView).withArea(6, 1)
             };
             grid.setGap(juce::Grid::Px(uiBase.getFontSize() * .4125f));
             auto bound = getLocalBounds().toFloat();
@@ -70,7 +76,7 @@ namespace zlPanel {
         juce::AudioProcessorValueTreeState &parametersNARef;
         zlInterface::UIBase &uiBase;
 
-        zlInterface::ClickCombobox fftPreON, fftPostON, fftSideON;
+        zlInterface::ClickCombobox fftPreON, fftPostON, fftSideON, phaseView;
         zlInterface::CompactCombobox ffTSpeed, fftTilt;
         juce::OwnedArray<juce::AudioProcessorValueTreeState::ComboBoxAttachment> boxAttachments{};
     };
@@ -126,7 +132,7 @@ namespace zlPanel {
         }
         auto content = std::make_unique<FFTCallOutBox>(parametersNARef, uiBase);
         content->setSize(juce::roundToInt(uiBase.getFontSize() * 7.f),
-                         juce::roundToInt(uiBase.getFontSize() * 11.2f));
+                         juce::roundToInt(uiBase.getFontSize() * 13.44f));
 
         auto &box = juce::CallOutBox::launchAsynchronously(std::move(content),
                                                            getBounds(),
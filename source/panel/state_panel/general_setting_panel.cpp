@@ -18,21 +18,24 @@ namespace zlPanel {
               uiBase(base),
               filterStructure("", zlDSP::filterStructure::choices, uiBase),
               zeroLATC("Zero LAT:", zlDSP::zeroLatency::choices, uiBase),
-              dynLinkC("Dyn Link:", zlDSP::dynLink::choices, uiBase) {
+              dynLinkC("Dyn Link:", zlDSP::dynLink::choices, uiBase),
+              precisionC("Precision:", zlDSP::precision::choices, uiBase) {
             for (auto &c: {&filterStructure}) {
                 addAndMakeVisible(c);
             }
-            for (auto &c: {&zeroLATC, &dynLinkC}) {
+            for (auto &c: {&zeroLATC, &dynLinkC, &precisionC}) {
                 c->getLabelLAF().setFontScale(1.5f);
                 c->setLabelScale(.625f);
                 c->setLabelPos(zlInterface::ClickCombobox::left);
                 addAndMakeVisible(c);
             }
             attach({
-                       &filterStructure.getBox(), &zeroLATC.getCompactBox().getBox(), &dynLinkC.getCompactBox().getBox()
+                       &filterStructure.getBox(), &zeroLATC.getCompactBox().getBox(), &dynLinkC.getCompactBox().getBox(),
+                       &precisionC.getCompactBox().getBox()
                    },
                    {
-                       zlDSP::filterStructure::ID, zlDSP::zeroLatency::ID, zlDSP::dynLink::ID
+                       zlDSP::filterStructure::ID, zlDSP::zeroLatency::ID, zlDSP::dynLink::ID,
+                       zlDSP::precision::ID
                    },
                    parametersRef, boxAttachments);
         }
@@ -44,13 +47,14 @@ namespace zlPanel {
             using Track = juce::Grid::TrackInfo;
             using Fr = juce::Grid::Fr;
 
-            grid.templateRows = {Track(Fr(44)), Track(Fr(44)), Track(Fr(44))};
+            grid.templateRows = {Track(Fr(44)), Track(Fr(44)), Track(Fr(44)), Track(Fr(44))};
             grid.templateColumns = {Track(Fr(50))};
 
             grid.items = {
                 juce::GridItem(filterStructure).withArea(1, 1),
                 juce::GridItem(zeroLATC).withArea(2, 1),
                 juce::GridItem(dynLinkC).withArea(3, 1),
+                juce::GridItem(precisionC).withArea(4, 1),
             };
             grid.setGap(juce::Grid::Px(uiBase.getFontSize() * .4125f));
             auto bound = getLocalBounds().toFloat();
@@ -63,7 +67,7 @@ namespace zlPanel {
         zlInterface::UIBase &uiBase;
 
         zlInterface::CompactCombobox filterStructure;
-        zlInterface::ClickCombobox zeroLATC, dynLinkC;
+        zlInterface::ClickCombobox zeroLATC, dynLinkC, precisionC;
         juce::OwnedArray<juce::AudioProcessorValueTreeState::ComboBoxAttachment> boxAttachments;
     };
 
@@ -118,7 +122,7 @@ namespace zlPanel {
         }
         auto content = std::make_unique<GeneralCallOutBox>(parametersRef, uiBase);
         content->setSize(juce::roundToInt(uiBase.getFontSize() * 10.f),
-                         juce::roundToInt(uiBase.getFontSize() * 6.6f));//4.3525f));
+                         juce::roundToInt(uiBase.getFontSize() * 8.8f));//4.3525f));
 
         auto &box = juce::CallOutBox::launchAsynchronously(std::move(content),
                                                            getBounds(),
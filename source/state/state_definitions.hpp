@@ -148,6 +148,16 @@ namespace zlState {
         int static constexpr defaultI = 3;
     };
 
+    class phaseView : public ChoiceParameters<phaseView> {
+    public:
+        auto static constexpr ID = "phase_view";
+        auto static constexpr name = "";
+        inline auto static const choices = juce::StringArray{
+            "OFF", "Phase", "Delay"
+        };
+        int static constexpr defaultI = 0;
+    };
+
     class active : public BoolParameters<active> {
     public:
         auto static constexpr ID = "active";
@@ -195,7 +205,8 @@ namespace zlState {
         layout.add(selectedBandIdx::get(), maximumDB::get(),
                    fftPreON::get(), fftPostON::get(), fftSideON::get(),
                    ffTOrder::get(), ffTSpeed::get(), ffTTilt::get(),
-                   conflictON::get(), conflictStrength::get(), conflictScale::get());
+                   conflictON::get(), conflictStrength::get(), conflictScale::get(),
+                   phaseView::get());
         for (int i = 0; i < bandNUM; ++i) {
             auto suffix = i < 10 ? "0" + std::to_string(i) : std::to_string(i);
             addOneBandParas(layout, suffix);
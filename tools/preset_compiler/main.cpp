@@ -0,0 +1,56 @@
+// Copyright (C) 2024 - zsliu98
+// This file is part of ZLEqualizer
+//
+// ZLEqualizer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//
+// ZLEqualizer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEqualizer. If not, see <https://www.gnu.org/licenses/>.
+
+// PresetCompiler <state file> <sample rate> [output file]
+// the state file is either the binary written by getStateInformation or its xml (ZLEqualizerParaState)
+// the compiled preset is written as plain text (see zlPreset::CompiledPreset::write) to the output file or stdout
+
+#include <fstream>
+#include <iostream>
+
+#include "dsp/preset/preset.hpp"
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "usage: PresetCompiler <state file> <sample rate> [output file]\n";
+        return 1;
+    }
+    const juce::File stateFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[1]);
+    const auto sampleRate = juce::String(argv[2]).getDoubleValue();
+
+    juce::MemoryBlock data;
+    if (!stateFile.loadFileAsData(data)) {
+        std::cerr << "cannot read " << argv[1] << "\n";
+        return 1;
+    }
+    zlPreset::CompiledPreset preset;
+    auto isCompiled = zlPreset::PresetCompiler::compile(data.getData(), static_cast<int>(data.getSize()),
+                                                        sampleRate, preset);
+    if (!isCompiled) {
+        if (const auto xml = juce::parseXML(stateFile)) {
+            isCompiled = zlPreset::PresetCompiler::compile(*xml, sampleRate, preset);
+        }
+    }
+    if (!isCompiled) {
+        std::cerr << "not a valid state of ZLEqualizer: " << argv[1] << "\n";
+        return 1;
+    }
+
+    if (argc > 3) {
+        std::ofstream output(argv[3]);
+        preset.write(output);
+        if (!output) {
+            std::cerr << "cannot write " << argv[3] << "\n";
+            return 1;
+        }
+    } else {
+        preset.write(std::cout);
+    }
+    return 0;
+}